@@ -13,28 +13,31 @@
 // #include <fmt/core.h>
 #include <fmt/format.h>
 
+#include "lib/extract.h"
 #include "lib/io.h"
 #include "lib/parse.h"
+#include "lib/phase.h"
+#include "lib/progress.h"
 #include "lib/run.h"
-#include "lib/to.h"
 
 namespace {
 
-struct Range {
-  size_t startDestination;
-  size_t startSource;
-  size_t length;
-};
+// Columns of the "destination source length" lines of a map.
+constexpr size_t kDestination = 0;
+constexpr size_t kSource = 1;
+constexpr size_t kLength = 2;
 
 struct AlmanacMap {
   std::string from;
   std::string to;
-  std::vector<Range> ranges;
+  // Kept as columns, so a lookup runs over the dense source and length columns.
+  IntColumns<size_t> ranges;
 
   size_t mapVal(size_t val) const {
-    for (const auto& range : ranges) {
-      if (val >= range.startSource && (val < (range.startSource + range.length))) {
-        val += (range.startDestination - range.startSource);
+    for (size_t row = 0; row < ranges.rows(); ++row) {
+      const auto startSource = ranges(row, kSource);
+      if (val >= startSource && (val < (startSource + ranges(row, kLength)))) {
+        val += (ranges(row, kDestination) - startSource);
         break;
       }
     }
@@ -49,6 +52,7 @@ struct Almanac {
 };
 
 Almanac readFile(const std::string& path) {
+  AOC_PHASE("parse");
   Almanac almanac{};
 
   auto sections = split(read(path), "\n\n", true);
@@ -57,28 +61,17 @@ Almanac readFile(const std::string& path) {
   auto& sectionSeeds = sections[0];
   auto [seedString, seedNumsString] = splitToPair(std::move(sectionSeeds), ":");
   assert(seedString == "seeds");
-  almanac.seeds = to<decltype(almanac.seeds)>(split(std::move(seedNumsString)));
+  extractInts<size_t>(seedNumsString, std::back_inserter(almanac.seeds));
   sections.erase(sections.begin());
 
   for (auto&& section : sections) {
     auto [sectionFromTo, sectionRanges] = splitToPair(std::move(section), " map:\n", true);
     const auto [sectionFrom, sectionTo] = splitToPair(std::move(sectionFromTo), "-to-", true);
 
-    auto sectionRangesSplit = split(std::move(sectionRanges), "\n");
-    std::vector<Range> ranges{};
-    std::transform(sectionRangesSplit.begin(), sectionRangesSplit.end(), std::back_inserter(ranges),
-                   [](auto& range) {
-                     auto nums = split(std::move(range));
-                     assert(nums.size() == 3);
-                     return Range{.startDestination = to<size_t>(std::move(nums[0])),
-                                  .startSource = to<size_t>(std::move(nums[1])),
-                                  .length = to<size_t>(std::move(nums[2]))};
-                   });
-
     almanac.maps.emplace_back(AlmanacMap{
         .from = std::move(sectionFrom),
         .to = std::move(sectionTo),
-        .ranges = std::move(ranges),
+        .ranges = extractIntColumns<size_t>(sectionRanges, 3),
     });
   }
 
@@ -86,12 +79,13 @@ Almanac readFile(const std::string& path) {
 }
 
 size_t lowestLocation(const Almanac& almanac, std::unordered_map<size_t, size_t>& cache) {
+  AOC_PHASE("solve");
   auto lowestLocation = std::numeric_limits<size_t>::max();
 
+  progressTotal(almanac.seeds.size());
   for (size_t i = 0; i < almanac.seeds.size(); ++i) {
-    if ((i % 50000000) == 0) {
-      // fmt::print("Processing seed {} / {}\n", i, almanac.seeds.size());
-    }
+    throwIfCancelled();
+    progress();
 
     const auto& seed = almanac.seeds[i];
     std::string currentFrom = "seed";
@@ -3,8 +3,8 @@
 #include <algorithm>
 #include <cassert>
 #include <cstddef>
+#include <cstdint>
 #include <iterator>
-#include <map>
 #include <numeric>
 #include <string>
 #include <utility>
@@ -16,6 +16,7 @@
 #include <fmt/format.h>
 
 #include "lib/io.h"
+#include "lib/memo.h"
 #include "lib/parse.h"
 #include "lib/run.h"
 #include "lib/to.h"
@@ -28,6 +29,20 @@ enum class Condition : char {
   Unknown = '?',
 };
 
+// Where a count of arrangements resumes: at conditions_[offset], with damagedGroups_[run] next.
+struct Position final {
+  size_t offset;
+  size_t run;
+};
+
+struct PackPosition final {
+  uint64_t operator()(const Position& position) const {
+    return (uint64_t{position.offset} << 32) | position.run;
+  }
+};
+
+using Cache = Memo<Position, size_t, PackPosition>;
+
 class Record final {
  public:
   Record(std::string&& conditions, std::vector<size_t>&& damagedGroups)
@@ -38,7 +53,15 @@ class Record final {
                std::string{to<char>(Condition::Operational), to<char>(Condition::Damaged),
                            to<char>(Condition::Unknown)}) == std::string::npos);
 
-    return countUnknownCombinations(conditions_, damagedGroups_);
+    // Cells the groups from run on need at least, with one operational cell between groups.
+    std::vector<size_t> needed(damagedGroups_.size() + 1, 0);
+    for (size_t run = damagedGroups_.size(); run-- > 0;) {
+      const size_t gap = (run + 1 < damagedGroups_.size()) ? 1 : 0;
+      needed[run] = needed[run + 1] + damagedGroups_[run] + gap;
+    }
+
+    Cache cache{};
+    return countUnknownCombinations({.offset = 0, .run = 0}, needed, cache);
   }
 
   std::string print() const {
@@ -58,77 +81,71 @@ class Record final {
   }
 
  private:
-  static size_t countUnknownCombinations(const std::string& line, const std::vector<size_t>& runs);
-  static std::map<std::pair<std::string, std::vector<size_t>>, size_t> combinationsCache_;
+  size_t countUnknownCombinations(Position position,
+                                  const std::vector<size_t>& needed,
+                                  Cache& cache) const;
+  size_t countDamagedGroup(Position position,
+                           const std::vector<size_t>& needed,
+                           Cache& cache) const;
 
   std::string conditions_;
   std::vector<size_t> damagedGroups_;
 };
 
-std::map<std::pair<std::string, std::vector<size_t>>, size_t> Record::combinationsCache_{};
-size_t Record::countUnknownCombinations(const std::string& line, const std::vector<size_t>& runs) {
-  std::pair<std::string, std::vector<size_t>> key = {line, runs};
-  if (const auto it = combinationsCache_.find(key); it != combinationsCache_.end()) {
-    return it->second;
-  }
+size_t Record::countUnknownCombinations(Position position,
+                                        const std::vector<size_t>& needed,
+                                        Cache& cache) const {
+  const auto [offset, run] = position;
+  const auto size = conditions_.size();
 
-  const auto returnAndCache = [cachedKey{std::move(key)}](size_t ret) {
-    if (const auto it = combinationsCache_.find(cachedKey); it != combinationsCache_.end()) {
-      assert(false);
-    }
-
-    combinationsCache_.emplace(cachedKey, ret);
-    return ret;
-  };
-
-  if (line.size() == 0) {
-    if (runs.size() == 0) {
-      return returnAndCache(1);
-    }
-    return returnAndCache(0);
+  if (offset == size) {
+    return (run == damagedGroups_.size()) ? 1 : 0;
   }
 
-  if (runs.size() == 0) {
-    for (size_t i = 0; i < line.size(); ++i) {
-      if ((i < line.size()) && line[i] == to<char>(Condition::Damaged)) {
-        return returnAndCache(0);
-      }
-    }
-    return returnAndCache(1);
+  if (run == damagedGroups_.size()) {
+    return (conditions_.find(to<char>(Condition::Damaged), offset) == std::string::npos) ? 1 : 0;
   }
 
-  const auto sumRuns = std::accumulate(runs.begin(), runs.end(), 0UL,
-                                       [](const auto& sum, const auto& run) { return sum + run; });
-  if (line.size() < (sumRuns + runs.size() - 1)) {
-    return returnAndCache(0);
+  if (size - offset < needed[run]) {
+    return 0;
   }
 
-  assert(runs.size() >= 1);
-  if (line[0] == to<char>(Condition::Operational)) {
-    return returnAndCache(countUnknownCombinations(line.substr(1), runs));
-  }
-
-  if (line[0] == to<char>(Condition::Damaged)) {
-    const auto run = runs.front();
-    const std::vector<size_t> leftover(std::next(runs.begin()), runs.end());
-    for (size_t i = 0; i < run; ++i) {
-      if ((i < line.size()) && line[i] == to<char>(Condition::Operational)) {
-        return returnAndCache(0);
-      }
+  return cache.get(position, [&] {
+    const auto operational = [&] {
+      return countUnknownCombinations({.offset = offset + 1, .run = run}, needed, cache);
+    };
+
+    switch (static_cast<Condition>(conditions_[offset])) {
+      case Condition::Operational:
+        return operational();
+      case Condition::Damaged:
+        return countDamagedGroup(position, needed, cache);
+      case Condition::Unknown:
+        return countDamagedGroup(position, needed, cache) + operational();
     }
+    return size_t{0};
+  });
+}
 
-    if ((run < line.size()) && (line[run] == to<char>(Condition::Damaged))) {
-      return returnAndCache(0);
+// Arrangements with group run starting at offset; needed guarantees the group fits.
+size_t Record::countDamagedGroup(Position position,
+                                 const std::vector<size_t>& needed,
+                                 Cache& cache) const {
+  const auto [offset, run] = position;
+  const auto end = offset + damagedGroups_[run];
+
+  for (size_t i = offset; i < end; ++i) {
+    if (conditions_[i] == to<char>(Condition::Operational)) {
+      return 0;
     }
+  }
 
-    return returnAndCache(
-        countUnknownCombinations(line.substr(std::min(line.size(), run + 1)), leftover));
+  if ((end < conditions_.size()) && (conditions_[end] == to<char>(Condition::Damaged))) {
+    return 0;
   }
 
-  return returnAndCache(
-      countUnknownCombinations(std::string{to<char>(Condition::Damaged)} + line.substr(1), runs) +
-      countUnknownCombinations(std::string{to<char>(Condition::Operational)} + line.substr(1),
-                               runs));
+  return countUnknownCombinations(
+      {.offset = std::min(conditions_.size(), end + 1), .run = run + 1}, needed, cache);
 }
 
 std::vector<Record> readFile(const std::string& path, bool log = false) {
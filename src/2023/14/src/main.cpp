@@ -3,8 +3,8 @@
 #include <algorithm>
 #include <cassert>
 #include <cstddef>
+#include <cstdint>
 #include <iterator>
-#include <map>
 #include <string>
 #include <utility>
 #include <vector>
@@ -15,6 +15,7 @@
 #include <fmt/format.h>
 #include <fmt/ranges.h>
 
+#include "lib/cycle.h"
 #include "lib/io.h"
 #include "lib/parse.h"
 #include "lib/run.h"
@@ -23,7 +24,15 @@ namespace {
 
 class Platform final {
  public:
-  Platform(std::vector<std::string>&& grid) : grid_{std::move(grid)} {}
+  Platform(std::vector<std::string>&& grid) : grid_{std::move(grid)} {
+    for (size_t r = 0; r < grid_.size(); ++r) {
+      for (size_t c = 0; c < grid_[r].size(); ++c) {
+        if (grid_[r][c] == 'O') {
+          hash_ ^= rockKey(c, r);
+        }
+      }
+    }
+  }
 
   enum class Direction {
     North,
@@ -51,62 +60,54 @@ class Platform final {
   }
 
   void tilt(const Direction& direction = Direction::North) {
-    bool movement = true;
-    const auto checkAndSwap = [this, &movement](const std::pair<size_t, size_t>& curr,
-                                                const std::pair<size_t, size_t>& prev) {
-      const auto& [x1, y1] = curr;
-      const auto& [x2, y2] = prev;
-
-      if ((grid_[y1][x1] == 'O') && (grid_[y2][x2] == '.')) {
-        movement = true;
-        grid_[y2][x2] = 'O';
-        grid_[y1][x1] = '.';
+    // Rolls every line of length cells towards its first one, cell(line, i) being the i-th cell
+    // from that end; each rock moves once, to just past the last rock or cube before it.
+    const auto roll = [this](size_t lines, size_t length, const auto& cell) {
+      for (size_t line = 0; line < lines; ++line) {
+        size_t free = 0;
+        for (size_t i = 0; i < length; ++i) {
+          const auto [x, y] = cell(line, i);
+          if (grid_[y][x] == '#') {
+            free = i + 1;
+          } else if (grid_[y][x] == 'O') {
+            if (i != free) {
+              const auto [toX, toY] = cell(line, free);
+              grid_[toY][toX] = 'O';
+              grid_[y][x] = '.';
+              hash_ ^= rockKey(x, y) ^ rockKey(toX, toY);
+            }
+            ++free;
+          }
+        }
       }
     };
 
-    while (movement) {
-      movement = false;
+    const auto rows = grid_.size();
+    const auto cols = grid_[0].size();
 
 #ifdef __clang__
 #pragma clang diagnostic push
 #pragma clang diagnostic ignored "-Wswitch-default"
 #endif
 
-      switch (direction) {
-        case Direction::North:
-          for (size_t r = 1; r < grid_.size(); ++r) {
-            for (size_t c = 0; c < grid_[r].size(); ++c) {
-              checkAndSwap({c, r}, {c, r - 1});
-            }
-          }
-          break;
-        case Direction::South:
-          for (size_t r = grid_.size() - 2; r < grid_.size(); --r) {
-            for (size_t c = 0; c < grid_[r].size(); ++c) {
-              checkAndSwap({c, r}, {c, r + 1});
-            }
-          }
-          break;
-        case Direction::West:
-          for (size_t c = 1; c < grid_[0].size(); ++c) {
-            for (size_t r = 0; r < grid_.size(); ++r) {
-              checkAndSwap({c, r}, {c - 1, r});
-            }
-          }
-          break;
-        case Direction::East:
-          for (size_t c = grid_[0].size() - 2; c < grid_[0].size(); --c) {
-            for (size_t r = 0; r < grid_.size(); ++r) {
-              checkAndSwap({c, r}, {c + 1, r});
-            }
-          }
-          break;
-      }
+    switch (direction) {
+      case Direction::North:
+        roll(cols, rows, [](size_t c, size_t i) { return std::pair{c, i}; });
+        break;
+      case Direction::South:
+        roll(cols, rows, [rows](size_t c, size_t i) { return std::pair{c, rows - 1 - i}; });
+        break;
+      case Direction::West:
+        roll(rows, cols, [](size_t r, size_t i) { return std::pair{i, r}; });
+        break;
+      case Direction::East:
+        roll(rows, cols, [cols](size_t r, size_t i) { return std::pair{cols - 1 - i, r}; });
+        break;
+    }
 
 #ifdef __clang__
 #pragma clang diagnostic pop
 #endif
-    }
   }
 
   void spin() {
@@ -118,8 +119,16 @@ class Platform final {
 
   const std::vector<std::string>& grid() { return grid_; }
 
+  // Zobrist hash of the cells with a round rock, kept up to date as rocks roll.
+  uint64_t hash() const { return hash_; }
+
+  bool operator==(const Platform& other) const = default;
+
  private:
+  uint64_t rockKey(size_t x, size_t y) const { return zobristKey((y * grid_[0].size()) + x); }
+
   std::vector<std::string> grid_;
+  uint64_t hash_ = 0;
 };
 
 Platform readFile(const std::string& path) {
@@ -144,27 +153,11 @@ size_t part1(const std::string& path) {
 
 size_t part2(const std::string& path) {
   auto platform = readFile(path);
-  std::map<std::vector<std::string>, size_t> lastSeen{};
 
   constexpr size_t kNumCycles = 1000000000;
-  bool fastForward = false;
-  for (size_t i = 0; i < kNumCycles; ++i) {
-    platform.spin();
-
-    if (!fastForward) {
-      if (const auto it = lastSeen.find(platform.grid()); it != lastSeen.end()) {
-        const auto& [_, lastIndex] = *it;
-        const auto period = i - lastIndex;
-        i += ((kNumCycles - i) / period) * period;
-        fastForward = true;
-      } else {
-        lastSeen.emplace(std::vector<std::string>{platform.grid()}, i);
-      }
-    }
-
-    // fmt::print("load: {:<10} {:>10} / {:<10} ({:.1f}%)\n", platform.load(), i, kNumCycles,
-    //            static_cast<double>(i) * (100. / static_cast<double>(kNumCycles)));
-  }
+  fastForward(
+      platform, kNumCycles, [](Platform& p) { p.spin(); },
+      [](const Platform& p) { return p.hash(); });
 
   return platform.load();
 }
@@ -5,11 +5,9 @@
 #include <cstddef>
 #include <cstdint>
 #include <iterator>
-#include <numeric>
 #include <optional>
 #include <ranges>
 #include <string>
-#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -18,6 +16,7 @@
 #endif
 #include <fmt/core.h>  // IWYU pragma: keep
 
+#include "lib/grid.h"
 #include "lib/io.h"
 #include "lib/parse.h"
 #include "lib/run.h"
@@ -157,45 +156,39 @@ std::vector<std::string> readFile(const std::string& path) {
   return grid;
 }
 
+// Bit of a direction in the per cell set of directions beams have passed through.
+constexpr uint8_t directionBit(Direction direction) {
+  return (direction == Direction::Up)     ? 1
+         : (direction == Direction::Down) ? 2
+         : (direction == Direction::Left) ? 4
+                                          : 8;
+}
+
 size_t energized(const std::vector<std::string>& grid, const Beam& beamStarting) {
-  const std::unordered_map<Direction, bool> directionsVisited = {
-      {Direction::Up, false},
-      {Direction::Down, false},
-      {Direction::Left, false},
-      {Direction::Right, false},
-  };
-
-  std::vector<std::vector<std::unordered_map<Direction, bool>>> visited(
-      grid.size(), decltype(visited)::value_type(grid[0].size(), directionsVisited));
+  Grid<uint8_t> visited{grid[0].size(), grid.size()};
   std::vector<Beam> beams{beamStarting};
 
   while (beams.size()) {
     const auto [beamBeginNew, beamEndNew] =
-        std::ranges::remove_if(beams, [&grid, &visited](const auto& beam) {
-          return ((beam.x >= grid[0].size()) || (beam.y >= grid.size()) ||
-                  (visited[beam.y][beam.x][beam.direction]));
+        std::ranges::remove_if(beams, [&visited](const auto& beam) {
+          return !visited.contains(beam.x, beam.y) ||
+                 ((visited.at(beam.x, beam.y) & directionBit(beam.direction)) != 0);
         });
     beams.erase(beamBeginNew, beamEndNew);
 
     for (size_t i = 0; i < beams.size(); ++i) {
       auto& beam = beams[i];
       const auto& [x, y, direction, _] = beam;
-      visited[y][x][direction] = true;
+      visited.at(x, y) = static_cast<uint8_t>(visited.at(x, y) | directionBit(direction));
       if (auto maybeNewBeam = beam.update(static_cast<Tile>(grid[y][x])); maybeNewBeam) {
         beams.emplace_back(std::move(*maybeNewBeam));
       }
     }
   }
 
-  // clang-format off
-  return std::accumulate(visited.begin(), visited.end(), size_t{}, [](const auto& sum, const auto& row) {
-    return sum + std::accumulate(row.begin(), row.end(), size_t{}, [](const auto& sumRow, const auto& e) {
-      return sumRow + std::ranges::any_of(e, [](const auto& pair) {
-        return pair.second;
-      });
-    });
-  });
-  // clang-format on
+  // Padding cells are never visited, so they count as not energized.
+  return static_cast<size_t>(
+      std::ranges::count_if(visited.cells(), [](uint8_t directions) { return directions != 0; }));
 }
 
 size_t part1(const std::string& path) {
@@ -19,17 +19,13 @@
 #include "lib/parse.h"
 #include "lib/run.h"
 
-std::vector<std::string> readFile(const std::string& path) {
-  return split(read(path), "\n");
-}
-
 std::pair<std::vector<size_t>, std::vector<size_t>> parse(const std::string& path) {
   std::vector<size_t> left;
   std::vector<size_t> right;
 
-  auto data = readFile(path);
-  for (auto&& line : data) {
-    const auto& [lhs, rhs] = splitToPair<size_t, size_t>(std::move(line));
+  const auto file = readMapped(path);
+  for (const auto line : splitView(file.view(), "\n")) {
+    const auto& [lhs, rhs] = splitToPair<size_t, size_t>(splitView(line));
     // fmt::print("lhs: {}, rhs: {}\n", lhs, rhs);
     left.emplace_back(lhs);
     right.emplace_back(rhs);
@@ -3,34 +3,22 @@
 #include <algorithm>
 #include <cmath>
 #include <cstddef>
+#include <functional>
 #include <iterator>
-#include <numeric>
 #include <string>
-#include <utility>
+#include <string_view>
 #include <vector>
 
 #include <sys/types.h>
 
 // #include <fmt/core.h>
 
-#include "lib/io.h"
+#include "lib/parallel.h"
 #include "lib/parse.h"
 #include "lib/run.h"
 
-std::vector<std::string> readFile(const std::string& path) {
-  return split(read(path), "\n");
-}
-
-std::vector<std::vector<size_t>> parse(const std::string& path) {
-  std::vector<std::vector<size_t>> reports;
-
-  auto data = readFile(path);
-  for (auto&& line : data) {
-    auto levels = splitTo<std::vector<size_t>>(std::move(line));
-    reports.emplace_back(std::move(levels));
-  }
-
-  return reports;
+std::vector<size_t> parse(std::string_view line) {
+  return splitTo<std::vector<size_t>>(split<" ">(line));
 }
 
 bool checkReport(const std::vector<size_t>& report) {
@@ -49,10 +37,10 @@ bool checkReport(const std::vector<size_t>& report) {
 }
 
 size_t checkReports(const std::string& path, auto&& checkFn) {
-  auto reports = parse(path);
-  return std::accumulate(
-      reports.begin(), reports.end(), 0UL,
-      [&checkFn](const auto& sum, const auto& report) { return sum + checkFn(report); });
+  return mapReduceLines(
+      path,
+      [&checkFn](std::string_view line) -> size_t { return checkFn(parse(line)) ? 1 : 0; },
+      std::plus<>{});
 }
 
 size_t part1(const std::string& path) {
@@ -23,17 +23,15 @@ struct Data {
 Data readFile(const std::string& path) {
   Data data;
 
-  auto [rulesStr, updatesStr] = splitToPair(read(path), "\n\n", true);
+  const auto file = readMapped(path);
+  const auto [rulesStr, updatesStr] = splitToPair(split<"\n\n", true>(file.view()));
 
-  auto rules = split(std::move(rulesStr), "\n");
-  for (auto&& rule : rules) {
-    auto [lhs, rhs] = splitToPair<size_t, size_t>(std::move(rule), "|");
-    data.rules.emplace_back(std::pair<size_t, size_t>{lhs, rhs});
+  for (const auto rule : split<"\n">(rulesStr)) {
+    data.rules.emplace_back(splitToPair<size_t, size_t>(split<"|">(rule)));
   }
 
-  auto updates = split(std::move(updatesStr), "\n");
-  for (auto&& update : updates) {
-    data.updates.emplace_back(splitTo<std::vector<size_t>>(std::move(update), ","));
+  for (const auto update : split<"\n">(updatesStr)) {
+    data.updates.emplace_back(splitTo<std::vector<size_t>>(split<",">(update)));
   }
 
   return data;
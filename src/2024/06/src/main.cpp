@@ -1,147 +1,91 @@
 // adventofcode.com/2024/day/6
 
+#include <array>
 #include <cassert>
 #include <cstddef>
-#include <limits>
-#include <numeric>
 #include <string>
 #include <utility>
-#include <vector>
 
 // #include <fmt/core.h>
 
-#include "lib/io.h"
-#include "lib/parse.h"
+#include "lib/bitgrid.h"
+#include "lib/grid.h"
 #include "lib/run.h"
 
-enum class Direction {
-  Up,
-  Right,
-  Down,
-  Left,
-};
+constexpr char kOutside = ' ';
 
-struct Grid {
-  std::vector<std::string> grid;
-  size_t row;
-  size_t col;
+struct Lab {
+  CharGrid grid;
+  size_t start;
 };
 
-std::vector<std::string> readFile(const std::string& path) {
-  return split(read(path), "\n");
-}
-
-Grid parse(const std::string& path) {
-  auto grid = readFile(path);
-
-  size_t row = std::numeric_limits<size_t>::max();
-  size_t col = std::numeric_limits<size_t>::max();
-
-  for (size_t r = 0; r < grid.size(); ++r) {
-    assert(grid[r].size() == grid[0].size());
-    for (size_t c = 0; c < grid[r].size(); ++c) {
-      if (grid[r][c] == '^') {
-        assert(row == std::numeric_limits<size_t>::max());
-        assert(col == std::numeric_limits<size_t>::max());
-        row = r;
-        col = c;
-      }
-    }
-  }
-
-  assert(row != std::numeric_limits<size_t>::max());
-  assert(col != std::numeric_limits<size_t>::max());
+Lab parse(const std::string& path) {
+  auto grid = readGrid(path, 1, kOutside);
+  const auto start = grid.find('^');
+  assert(start != std::string::npos);
 
-  return Grid{
+  return Lab{
       .grid = std::move(grid),
-      .row = row,
-      .col = col,
+      .start = start,
   };
 }
 
-bool exitGrid(std::vector<std::string>& grid,
-              size_t row,
-              size_t col,
-              Direction direction = Direction::Up) {
-  const size_t maxOldSpots = (2 * grid.size()) + (2 * grid[0].size()) + 1;
-  size_t oldSpots = 0;
-  // fmt::println("\n\n{} {}", __func__, maxOldSpots);
-
-  while ((row < grid.size()) && (col < grid[0].size())) {
-    if (grid[row][col] == 'X') {
-      ++oldSpots;
-      // fmt::println("row: {}, col: {}, oldSpots: {}", row, col, oldSpots);
-    } else {
-      oldSpots = 0;
-    }
+// Cells the guard has been on, one grid per heading.
+using Visited = std::array<BitGrid, 4>;
 
-    if (oldSpots > maxOldSpots) {
+Visited makeVisited(const CharGrid& grid) {
+  const BitGrid empty{grid.width(), grid.height()};
+  return {empty, empty, empty, empty};
+}
+
+// Walks the guard from i until it leaves the grid (true) or is back on a cell with a heading it
+// has had there before, i.e. loops (false).
+bool exitGrid(const CharGrid& grid, Visited& visited, size_t i, size_t direction = CharGrid::kUp) {
+  while (grid[i] != kOutside) {
+    if (visited[direction].testAndSet(grid.x(i), grid.y(i))) {
       return false;  // loop detected
     }
 
-    grid[row][col] = 'X';
-    switch (direction) {
-      case Direction::Up:
-        if ((row == 0) || (grid[row - 1][col] != '#')) {
-          --row;
-        } else {
-          direction = Direction::Right;
-        }
-        break;
-      case Direction::Right:
-        if ((col == (grid[row].size() - 1)) || (grid[row][col + 1] != '#')) {
-          ++col;
-        } else {
-          direction = Direction::Down;
-        }
-        break;
-      case Direction::Down:
-        if ((row == (grid.size() - 1)) || (grid[row + 1][col] != '#')) {
-          ++row;
-        } else {
-          direction = Direction::Left;
-        }
-        break;
-      case Direction::Left:
-        if ((col == 0) || (grid[row][col - 1] != '#')) {
-          --col;
-        } else {
-          direction = Direction::Up;
-        }
-        break;
-      default:
-        assert(false);
-        break;
+    // Directions are clockwise, so turning right is the next one.
+    if (const auto next = grid.move(i, direction); grid[next] != '#') {
+      i = next;
+    } else {
+      direction = (direction + 1) % 4;
     }
   }
 
   return true;
 }
 
+// Cells the guard walks over on its way out.
+BitGrid guardPath(const Lab& lab) {
+  auto visited = makeVisited(lab.grid);
+  [[maybe_unused]] const auto exited = exitGrid(lab.grid, visited, lab.start);
+  assert(exited);
+  return visited[0] | visited[1] | visited[2] | visited[3];
+}
+
 size_t part1(const std::string& path) {
-  auto grid = parse(path);
-  assert(exitGrid(grid.grid, grid.row, grid.col));
-  return std::accumulate(
-      grid.grid.begin(), grid.grid.end(), 0UL, [](const auto& sum, const auto& gridRow) {
-        return sum + std::accumulate(
-                         gridRow.begin(), gridRow.end(), 0UL,
-                         [](const auto& rowSum, const auto& ch) { return rowSum + (ch == 'X'); });
-      });
+  return guardPath(parse(path)).count();
 }
 
 size_t part2(const std::string& path) {
-  auto grid = parse(path);
+  auto lab = parse(path);
+  auto visited = makeVisited(lab.grid);
 
+  // An obstacle off the guard's path leaves the path as it is.
   size_t obstacles = 0;
-  for (size_t r = 0; r < grid.grid.size(); ++r) {
-    for (size_t c = 0; c < grid.grid[r].size(); ++c) {
-      auto copy = grid.grid;
-      copy[r][c] = '#';
-      if (!exitGrid(copy, grid.row, grid.col)) {
-        ++obstacles;
-      }
+  guardPath(lab).forEachSet([&](size_t x, size_t y) {
+    const auto cell = lab.grid.at(x, y);
+    lab.grid.at(x, y) = '#';
+    for (auto& heading : visited) {
+      heading.clear();
     }
-  }
+    if (!exitGrid(lab.grid, visited, lab.start)) {
+      ++obstacles;
+    }
+    lab.grid.at(x, y) = cell;
+  });
 
   return obstacles;
 }
@@ -2,15 +2,16 @@
 
 #include <cassert>
 #include <cstddef>
+#include <functional>
 #include <iterator>
 #include <string>
-#include <utility>
+#include <string_view>
 #include <vector>
 
 // #include <fmt/core.h>
 #include <fmt/format.h>
 
-#include "lib/io.h"
+#include "lib/parallel.h"
 #include "lib/parse.h"
 #include "lib/run.h"
 #include "lib/to.h"
@@ -26,21 +27,9 @@ enum class Operator {
   Concatenate,
 };
 
-std::vector<std::string> readFile(const std::string& path) {
-  return split(read(path), "\n");
-}
-
-std::vector<Calibration> parse(const std::string& path) {
-  auto data = readFile(path);
-
-  std::vector<Calibration> calibrations;
-  for (auto&& line : data) {
-    auto [targetStr, numsStr] = splitToPair(std::move(line), ":");
-    auto nums = splitTo<std::vector<size_t>>(std::move(numsStr));
-    calibrations.emplace_back(to<size_t>(std::move(targetStr)), std::move(nums));
-  }
-
-  return calibrations;
+Calibration parse(std::string_view line) {
+  const auto [target, nums] = splitToPair<size_t>(split<":">(line));
+  return Calibration{.target = target, .nums = splitTo<std::vector<size_t>>(split<" ">(nums))};
 }
 
 bool evaluate(const std::vector<size_t>& nums, size_t target, const std::vector<Operator>& ops) {
@@ -79,16 +68,13 @@ bool evaluate(const std::vector<size_t>& nums, size_t target, const std::vector<
 }
 
 size_t solve(const std::string& path, const std::vector<Operator>& ops) {
-  const auto calibrations = parse(path);
-
-  size_t result = 0;
-  for (const auto& [target, nums] : calibrations) {
-    if (evaluate(nums, target, ops)) {
-      result += target;
-    }
-  }
-
-  return result;
+  return mapReduceLines(
+      path,
+      [&ops](std::string_view line) {
+        const auto [target, nums] = parse(line);
+        return evaluate(nums, target, ops) ? target : 0;
+      },
+      std::plus<>{});
 }
 
 size_t part1(const std::string& path) {
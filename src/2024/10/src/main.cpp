@@ -1,84 +1,48 @@
 // adventofcode.com/2024/day/10
 
-#include <algorithm>
 #include <cstddef>
-#include <iterator>
 #include <string>
-#include <utility>
 #include <vector>
 
-#include <sys/types.h>
-
 // #include <fmt/core.h>
 
-#include "lib/io.h"
-#include "lib/parse.h"
+#include "lib/grid.h"
 #include "lib/run.h"
-#include "lib/to.h"
-
-std::vector<std::string> readFile(const std::string& path) {
-  return split(read(path), "\n");
-}
 
-std::vector<std::vector<ssize_t>> parse(const std::string& path) {
-  std::vector<std::vector<ssize_t>> grid;
-  for (auto&& line : readFile(path)) {
-    std::vector<ssize_t> row;
-    std::transform(line.begin(), line.end(), std::back_inserter(row),
-                   [](const auto& ch) { return to<ssize_t>(std::string{ch}); });
-    grid.emplace_back(std::move(row));
-  }
-
-  return grid;
+// '.' borders never continue a trail, so neighbours need no bounds checks.
+CharGrid parse(const std::string& path) {
+  return readGrid(path, 1, '.');
 }
 
-size_t score(const std::vector<std::vector<ssize_t>>& grid,
-             std::vector<std::vector<size_t>>& seen,
-             ssize_t r,
-             ssize_t c,
-             bool part2) {
-  const auto r_ = static_cast<size_t>(r);
-  const auto c_ = static_cast<size_t>(c);
-
-  size_t result = 0;
-  if (grid[r_][c_] == 9) {
-    if (!part2) {
-      if (seen[r_][c_] == 0) {
-        result = 1;
-      }
-      ++seen[r_][c_];
-      return result;
-    } else {  // part 2
+size_t score(const CharGrid& grid, std::vector<bool>& seen, size_t i, bool part2) {
+  if (grid[i] == '9') {
+    if (part2) {
       return 1;
     }
+    if (seen[i]) {
+      return 0;
+    }
+    seen[i] = true;
+    return 1;
   }
 
-  ssize_t height = grid[r_][c_];
-
-  const auto valid = [&grid](const auto& row, const auto& col) {
-    return ((row >= 0) && (row < static_cast<decltype(row)>(grid.size())) && (col >= 0) &&
-            (col < static_cast<decltype(col)>(grid[static_cast<size_t>(row)].size())));
-  };
-
-  const std::vector<std::pair<ssize_t, ssize_t>> directions = {{1, 0}, {0, 1}, {-1, 0}, {0, -1}};
-  for (const auto& [dirR, dirC] : directions) {
-    if (valid(r + dirR, c + dirC) &&
-        grid[static_cast<size_t>(r + dirR)][static_cast<size_t>(c + dirC)] == height + 1) {
-      result += score(grid, seen, r + dirR, c + dirC, part2);
+  size_t result = 0;
+  for (size_t direction = 0; direction < 4; ++direction) {
+    const auto next = grid.move(i, direction);
+    if (grid[next] == grid[i] + 1) {
+      result += score(grid, seen, next, part2);
     }
   }
 
   return result;
 }
 
-size_t solve(const std::vector<std::vector<ssize_t>>& grid, bool part2 = false) {
+size_t solve(const CharGrid& grid, bool part2 = false) {
   size_t result = 0;
-  for (size_t r = 0; r < grid.size(); ++r) {
-    for (size_t c = 0; c < grid[r].size(); ++c) {
-      if (grid[r][c] == 0) {
-        std::vector<std::vector<size_t>> seen(grid.size(), std::vector<size_t>(grid[r].size(), 0));
-        result += score(grid, seen, static_cast<ssize_t>(r), static_cast<ssize_t>(c), part2);
-      }
+  for (size_t i = 0; i < grid.size(); ++i) {
+    if (grid[i] == '0') {
+      std::vector<bool> seen(grid.size(), false);
+      result += score(grid, seen, i, part2);
     }
   }
 
@@ -2,28 +2,26 @@
 
 #include <cassert>
 #include <cstddef>
-#include <list>
 #include <map>
+#include <memory_resource>
 #include <numeric>
 #include <string>
+#include <string_view>
 #include <utility>
 #include <vector>
 
 // #include <fmt/core.h>
 
+#include "lib/arena.h"
 #include "lib/io.h"
 #include "lib/parse.h"
 #include "lib/run.h"
 #include "lib/to.h"
 
-std::vector<std::string> readFile(const std::string& path) {
-  return split(read(path), "\n");
-}
-
-std::list<size_t> parse(const std::string& path) {
-  auto data = readFile(path);
-  assert(data.size() == 1);
-  return splitTo<std::list<size_t>>(std::move(data[0]), " ");
+std::pmr::vector<size_t> parse(const std::string& path) {
+  const auto file = readMapped(path);
+  assert(file.view().find('\n') == std::string_view::npos);
+  return splitTo<std::pmr::vector<size_t>>(split<" ">(file.view()), runArena().resource());
 }
 
 // size_t blink(const std::string& path, size_t turns) {
@@ -11,6 +11,8 @@
 
 // #include <fmt/core.h>
 
+#include "lib/bitgrid.h"
+#include "lib/grid.h"
 #include "lib/io.h"
 #include "lib/parse.h"
 #include "lib/run.h"
@@ -23,17 +25,16 @@ void traverse(char ch,
               size_t r,
               size_t c,
               const std::vector<std::string>& grid,
-              std::vector<std::vector<bool>>& seen,
+              BitGrid& seen,
               std::vector<std::pair<size_t, size_t>>& region) {
-  if (r >= grid.size() || c >= grid[r].size() || seen[r][c] || grid[r][c] != ch) {
+  if (!seen.contains(c, r) || seen.test(c, r) || grid[r][c] != ch) {
     return;
   }
 
-  seen[r][c] = true;
+  seen.set(c, r);
   region.emplace_back(r, c);
 
-  const std::vector<std::pair<ssize_t, ssize_t>> directions = {{1, 0}, {0, 1}, {-1, 0}, {0, -1}};
-  for (const auto& [dirR, dirC] : directions) {
+  for (const auto& [dirC, dirR] : kNeighbours4) {
     const auto newR = static_cast<size_t>(static_cast<ssize_t>(r) + dirR);
     const auto newC = static_cast<size_t>(static_cast<ssize_t>(c) + dirC);
 
@@ -44,7 +45,7 @@ void traverse(char ch,
 std::vector<std::vector<std::pair<size_t, size_t>>> findRegions(
     const std::vector<std::string>& grid) {
   std::vector<std::vector<std::pair<size_t, size_t>>> regions;
-  std::vector<std::vector<bool>> seen(grid.size(), std::vector<bool>(grid[0].size(), false));
+  BitGrid seen{grid[0].size(), grid.size()};
   // fmt::println("seen: {}", seen);
 
   for (size_t r = 0; r < grid.size(); ++r) {
@@ -65,10 +66,9 @@ size_t perimeter(const std::vector<std::string>& grid,
                  const std::vector<std::pair<size_t, size_t>>& region,
                  bool bulk) {
   size_t perimeter = 0;
-  const std::vector<std::pair<ssize_t, ssize_t>> directions = {{1, 0}, {0, 1}, {-1, 0}, {0, -1}};
 
   for (const auto& [r, c] : region) {
-    for (const auto& [dirR, dirC] : directions) {
+    for (const auto& [dirC, dirR] : kNeighbours4) {
       const auto newR = static_cast<size_t>(static_cast<ssize_t>(r) + dirR);
       const auto newC = static_cast<size_t>(static_cast<ssize_t>(c) + dirC);
 
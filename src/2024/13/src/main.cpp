@@ -16,7 +16,7 @@
 #include "lib/io.h"
 #include "lib/parse.h"
 #include "lib/run.h"
-#include "lib/to.h"
+#include "lib/scan.h"
 
 struct Game final {
   struct Point final {
@@ -29,41 +29,19 @@ struct Game final {
   Point prize;
 };
 
-std::vector<std::string> readFile(const std::string& path) {
-  return split(read(path), "\n\n", true);
-}
-
 std::vector<Game> parse(const std::string& path) {
-  auto gamesStr = readFile(path);
+  const auto file = readMapped(path);
   std::vector<Game> games{};
 
-  for (auto&& gameStr : gamesStr) {
-    const auto button = [](std::string&& line, char expected) {
-      auto parts = split(std::move(line), " :,+");
-      assert(parts.size() == 6);
-      assert(parts[0] == "Button");
-      assert(parts[1] == std::string{expected});
-      assert(parts[2] == "X");
-      assert(parts[4] == "Y");
-
-      return Game::Point{to<size_t>(std::move(parts[3])), to<size_t>(std::move(parts[5]))};
-    };
-
-    const auto prize = [](std::string&& line) {
-      auto parts = split(std::move(line), " :,=");
-      assert(parts.size() == 5);
-      assert(parts[0] == "Prize");
-      assert(parts[1] == "X");
-      assert(parts[3] == "Y");
-
-      return Game::Point{to<size_t>(std::move(parts[2])), to<size_t>(std::move(parts[4]))};
-    };
-
-    auto lines = split(std::move(gameStr), "\n");
-    assert(lines.size() == 3);
-    games.emplace_back(Game{.deltaA = button(std::move(lines[0]), 'A'),
-                            .deltaB = button(std::move(lines[1]), 'B'),
-                            .prize = prize(std::move(lines[2]))});
+  for (const auto gameStr : split<"\n\n", true>(file.view())) {
+    Game game{};
+    [[maybe_unused]] const auto scanned =
+        scanInto<"Button A: X+{}, Y+{}\nButton B: X+{}, Y+{}\nPrize: X={}, Y={}">(
+            gameStr, game.deltaA.x, game.deltaA.y, game.deltaB.x, game.deltaB.y, game.prize.x,
+            game.prize.y);
+    assert(scanned);
+
+    games.emplace_back(game);
   }
 
   return games;
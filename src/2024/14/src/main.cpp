@@ -1,59 +1,54 @@
 // adventofcode.com/2024/day/14
 
 #include <array>
+#include <bit>
 #include <cassert>
 #include <cstddef>
+#include <cstdint>
 #include <functional>
 #include <numeric>
+#include <stdexcept>
 #include <string>
 #include <utility>
 #include <vector>
 
 #include <sys/types.h>
 
-// #include <fmt/core.h>
+#include <fmt/format.h>
 
+#include "lib/bitgrid.h"
+#include "lib/cycle.h"
 #include "lib/io.h"
 #include "lib/parse.h"
 #include "lib/run.h"
-#include "lib/to.h"
+#include "lib/scan.h"
 
 struct Robot {
   struct Point {
     ssize_t x;
     ssize_t y;
+
+    bool operator==(const Point& other) const = default;
   };
 
   Point position;
   Point velocity;
-};
 
-std::vector<std::string> readFile(const std::string& path) {
-  return split(read(path), "\n");
-}
+  bool operator==(const Robot& other) const = default;
+};
 
 std::vector<Robot> parse(const std::string& path) {
-  auto lines = readFile(path);
+  const auto file = readMapped(path);
   std::vector<Robot> robots{};
 
-  for (auto&& robotStr : lines) {
-    auto parts = split(std::move(robotStr), "=, ");
-    assert(parts.size() == 6);
-    assert(parts[0] == "p");
-    assert(parts[3] == "v");
-
-    robots.emplace_back(Robot{
-        .position =
-            {
-                .x = to<ssize_t>(std::move(parts[1])),
-                .y = to<ssize_t>(std::move(parts[2])),
-            },
-        .velocity =
-            {
-                .x = to<ssize_t>(std::move(parts[4])),
-                .y = to<ssize_t>(std::move(parts[5])),
-            },
-    });
+  for (const auto line : split<"\n">(file.view())) {
+    Robot robot{};
+    [[maybe_unused]] const auto scanned =
+        scanInto<"p={},{} v={},{}">(line, robot.position.x, robot.position.y, robot.velocity.x,
+                                    robot.velocity.y);
+    assert(scanned);
+
+    robots.emplace_back(robot);
   }
 
   return robots;
@@ -117,36 +112,48 @@ size_t simulate(const std::string& path, ssize_t sizeX, ssize_t sizeY, size_t se
   return std::accumulate(quadrants.begin(), quadrants.end(), 1UL, std::multiplies<size_t>());
 }
 
+// Seconds until no two robots share a cell. Positions repeat after at most sizeX * sizeY seconds,
+// so if they do before that happens there is no tree to find.
 size_t tree(const std::string& path, ssize_t sizeX, ssize_t sizeY) {
   auto robots = parse(path);
-  size_t count = 0;
-  std::vector<std::vector<bool>> grid{};
-  size_t num = 0;
-  do {
-    ++count;
-    num = 0;
-    grid = std::vector<std::vector<bool>>(static_cast<size_t>(sizeY),
-                                          std::vector<bool>(static_cast<size_t>(sizeX), false));
-
-    advance(robots, sizeX, sizeY);
+  BitGrid grid{static_cast<size_t>(sizeX), static_cast<size_t>(sizeY)};
+
+  // Sets the robots' cells in grid and returns how many there are and a hash of them, both a word
+  // of cells at a time: the sum of each word times a random odd key for its place. The hash leaves
+  // out which robot is where, so arrangements that differ only in that collide; the finder tells
+  // them apart by comparing the robots.
+  std::vector<uint64_t> keys(grid.height() * grid.wordsPerRow());
+  for (size_t k = 0; k < keys.size(); ++k) {
+    keys[k] = zobristKey(k) | 1;
+  }
+  const auto place = [&robots, &grid, &keys]() {
     for (const auto& robot : robots) {
-      const auto x = static_cast<size_t>(robot.position.x);
-      const auto y = static_cast<size_t>(robot.position.y);
-      grid[y][x] = true;
+      grid.set(static_cast<size_t>(robot.position.x), static_cast<size_t>(robot.position.y));
     }
+    size_t cells = 0;
+    uint64_t hash = 0;
+    for (size_t y = 0, k = 0; y < grid.height(); ++y) {
+      for (const auto word : grid.row(y)) {
+        cells += static_cast<size_t>(std::popcount(word));
+        hash += word * keys[k++];
+      }
+    }
+    return std::pair{cells, hash};
+  };
 
-    num = std::accumulate(grid.begin(), grid.end(), 0UL, [](const auto& sum, const auto& row) {
-      return sum +
-             std::accumulate(row.begin(), row.end(), 0UL,
-                             [](const auto& rowSum, const auto& val) { return rowSum + val; });
-    });
-
-    // fmt::println("count: {}, num: {}, robots.size: {}, grid: {}\n\n", count, num, robots.size(),
-    // grid);
-
-  } while (num != robots.size());
-
-  return count;
+  CycleFinder finder{robots, place().second};
+  for (size_t count = 1;; ++count) {
+    grid.clear();
+    advance(robots, sizeX, sizeY);
+    const auto [cells, hash] = place();
+    if (cells == robots.size()) {
+      return count;
+    }
+    if (const auto period = finder.next(robots, hash); period != 0) {
+      throw std::runtime_error(
+          fmt::format("Robots overlap in every arrangement, which repeat every {}s", period));
+    }
+  }
 }
 
 size_t part1(const std::string& path) {
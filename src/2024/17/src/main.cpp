@@ -8,6 +8,7 @@
 #include <numeric>
 #include <stdexcept>
 #include <string>
+#include <string_view>
 #include <utility>
 #include <vector>
 
@@ -25,8 +26,9 @@
 
 #include "lib/io.h"
 #include "lib/parse.h"
+#include "lib/progress.h"
 #include "lib/run.h"
-#include "lib/to.h"
+#include "lib/scan.h"
 
 struct Computer {
   size_t a;
@@ -36,35 +38,18 @@ struct Computer {
   std::vector<size_t> program;
 };
 
-std::vector<std::string> readFile(const std::string& path) {
-  return split(read(path), "\n\n", true);
-}
-
 Computer parse(const std::string& path) {
-  auto data = readFile(path);
-  assert(data.size() == 2);
-
-  auto registersStrs = split(std::move(data[0]), "\n");
-  assert(registersStrs.size() == 3);
-
-  const auto registerStr = [&registersStrs](size_t i, char ch) {
-    auto str = split(std::move(registersStrs[i]), "Register:\n");
-    assert(str.size() == 3);
-    assert(str[0] == "");
-    assert(str[1] == std::string{ch});
-    return str[2];
-  };
+  const auto file = readMapped(path);
+  Computer computer{};
+  std::string_view programStr{};
 
-  auto programStr = split(std::move(data[1]), "Program:");
-  assert(programStr.size() == 2);
-  assert(programStr[0] == "");
+  [[maybe_unused]] const auto scanned =
+      scanInto<"Register A: {}\nRegister B: {}\nRegister C: {}\n\nProgram: {}">(
+          file.view(), computer.a, computer.b, computer.c, programStr);
+  assert(scanned);
 
-  return {
-      .a = to<size_t>(registerStr(0, 'A')),
-      .b = to<size_t>(registerStr(1, 'B')),
-      .c = to<size_t>(registerStr(2, 'C')),
-      .program = splitTo<std::vector<size_t>>(std::move(programStr[1]), ","),
-  };
+  computer.program = splitTo<std::vector<size_t>>(split<",">(programStr));
+  return computer;
 }
 
 std::string simulate(const std::string& path, ssize_t registerA = -1) {
@@ -174,9 +159,10 @@ size_t fixRegisterA(const std::string& path, size_t cheatStart = 0) {
 
   auto nums = boost::irange<size_t>(cheatStart, SIZE_MAX / 2);
   std::any_of(std::execution::par, nums.begin(), nums.end(), [&path, &expectedStr, &idx](size_t i) {
-    // if (i && (i % 1'000'000 == 0)) {
-    // fmt::println("{}", i);
-    // }
+    if (cancelled()) {
+      return true;
+    }
+    progress();
 
     try {
       if (simulate(path, static_cast<ssize_t>(i)) == expectedStr) {
@@ -230,5 +216,6 @@ int main() {
   run(1, part1, true, "4,6,3,5,6,3,5,2,1,0");
   run(1, part1, false, "6,5,7,4,5,7,3,1,0");
   run(2, part2, true, 117440UL, "data/example2.txt");
-  // run(2, part2, false, 105875099912602UL); // TODO: make part 2 performant without 'cheatStart'
+  // TODO: make part 2 performant without 'cheatStart'
+  // run(2, part2, false, 105875099912602UL, std::chrono::minutes{10});
 }
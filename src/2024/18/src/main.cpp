@@ -2,106 +2,84 @@
 
 #include <cstddef>
 #include <iterator>  // IWYU pragma: keep
-#include <limits>
-#include <queue>
 #include <string>
 #include <utility>
 #include <vector>
 
-#include <sys/types.h>
-
 #include <fmt/format.h>
 
+#include "lib/bitgrid.h"
+#include "lib/grid.h"
 #include "lib/io.h"
 #include "lib/parse.h"
 #include "lib/run.h"
+#include "lib/search.h"
 
 std::vector<std::string> readFile(const std::string& path) {
   return split(read(path), "\n");
 }
 
-std::vector<std::pair<size_t, size_t>> parse(const std::string& path) {
+struct Memory {
+  std::vector<std::string> lines;
   std::vector<std::pair<size_t, size_t>> points;
+  size_t rowCol;
+  size_t turns;
+};
 
-  auto lines = readFile(path);
-  for (auto&& line : lines) {
-    const auto [c, r] = splitToPair<size_t, size_t>(std::move(line), ",");
-    points.emplace_back(r, c);
+Memory parse(const std::string& path) {
+  const bool example = (path == "data/example.txt");
+  Memory memory{
+      .lines = readFile(path),
+      .points = {},
+      .rowCol = example ? 6UL : 70UL,
+      .turns = example ? 12UL : 1024UL,
+  };
+
+  for (const auto& line : memory.lines) {
+    const auto [c, r] = splitToPair<size_t, size_t>(std::string{line}, ",");
+    memory.points.emplace_back(r, c);
   }
 
-  return points;
+  return memory;
 }
 
-size_t simulate(const std::string& path, size_t turns, size_t rows, size_t cols) {
-  const auto data = parse(path);
-  const std::pair<size_t, size_t> start = {0, 0};
-  const std::pair<size_t, size_t> end = {rows, cols};
-  const std::vector<std::pair<ssize_t, ssize_t>> directions = {{0, 1}, {0, -1}, {1, 0}, {-1, 0}};
-
-  std::vector<std::vector<size_t>> grid((rows + 1), std::vector<size_t>((cols + 1), 0));
+size_t simulate(const std::vector<std::pair<size_t, size_t>>& data,
+                size_t turns,
+                size_t rows,
+                size_t cols) {
+  BitGrid corrupted{cols + 1, rows + 1};
   for (size_t i = 0; i <= turns; ++i) {
     const auto& [r, c] = data[i];
-    grid[r][c] = 1;
+    corrupted.set(c, r);
   }
 
-  std::vector<std::vector<size_t>> visited((rows + 1), std::vector<size_t>((cols + 1), 0));
-  std::vector<std::vector<size_t>> distance((rows + 1), std::vector<size_t>((cols + 1), 0));
-  std::queue<std::pair<std::pair<size_t, size_t>, size_t>> queue;
-  queue.emplace(start, 0);
-
-  const auto& [rStart, cStart] = start;
-  visited[rStart][cStart] = 1;
-
-  while (!queue.empty()) {
-    const auto [curr, d] = queue.front();
-    queue.pop();
-
-    if (curr == end) {
-      return d;
-    }
-
-    for (const auto& dir : directions) {
-      const auto& [rDir, cDir] = dir;
-      const auto& [rCurr, cCurr] = curr;
-
-      const size_t r = static_cast<size_t>(static_cast<ssize_t>(rCurr) + rDir);
-      const size_t c = static_cast<size_t>(static_cast<ssize_t>(cCurr) + cDir);
-
-      if ((r > rows) || (c > cols) || visited[r][c] || grid[r][c]) {
-        continue;
+  // States are (r * (cols + 1)) + c.
+  const auto state = [cols](size_t r, size_t c) { return (r * (cols + 1)) + c; };
+  const auto neighbours = [&](size_t curr, const auto& visit) {
+    for (const auto& [cDir, rDir] : kNeighbours4) {
+      const auto r = (curr / (cols + 1)) + static_cast<size_t>(rDir);
+      const auto c = (curr % (cols + 1)) + static_cast<size_t>(cDir);
+      if (corrupted.contains(c, r) && !corrupted.test(c, r)) {
+        visit(state(r, c));
       }
-
-      visited[r][c] = 1;
-      distance[r][c] = d + 1;
-      queue.emplace(std::pair<size_t, size_t>{r, c}, d + 1);
     }
-  }
-
-  const auto& [rEnd, cEnd] = end;
-  if (!visited[rEnd][cEnd]) {
-    return std::numeric_limits<size_t>::max();
-  }
+  };
 
-  return distance[rEnd][cEnd];
+  const auto end = state(rows, cols);
+  return bfs((rows + 1) * (cols + 1), {state(0, 0)}, neighbours,
+             [end](size_t curr) { return curr == end; })
+      .distance(end);
 }
 
-size_t part1(const std::string& path) {
-  const bool example = (path == "data/example.txt");
-  const size_t rowCol = example ? 6 : 70;
-  const size_t turns = example ? 12 : 1024;
-
-  return simulate(path, turns, rowCol, rowCol);
+size_t part1(const Memory& memory) {
+  return simulate(memory.points, memory.turns, memory.rowCol, memory.rowCol);
 }
 
-std::string part2(const std::string& path) {
-  const bool example = (path == "data/example.txt");
-  const size_t rowCol = example ? 6 : 70;
-
-  const auto raw = readFile(path);
-  for (size_t i = 0; i < raw.size(); ++i) {
-    const size_t d = simulate(path, i, rowCol, rowCol);
-    if (d == std::numeric_limits<size_t>::max()) {
-      return raw[i];
+std::string part2(const Memory& memory) {
+  for (size_t i = 0; i < memory.points.size(); ++i) {
+    const size_t d = simulate(memory.points, i, memory.rowCol, memory.rowCol);
+    if (d == kUnreached) {
+      return memory.lines[i];
     }
   }
 
@@ -109,8 +87,7 @@ std::string part2(const std::string& path) {
 }
 
 int main() {
-  // run(1, part1, true, 22UL); // is the example wrong? getting 24...
-  run(1, part1, false, 404UL);
-  run(2, part2, true, "6,1");
-  run(2, part2, false, "27,60");
+  // is the part 1 example wrong? getting 24 instead of 22...
+  run(parse, part1, part2, true, kSkip, "6,1");
+  run(parse, part1, part2, false, 404UL, "27,60");
 }
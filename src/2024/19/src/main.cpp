@@ -1,17 +1,16 @@
 // adventofcode.com/2024/day/19
 
-#include <cassert>
 #include <cstddef>
 #include <numeric>
 #include <string>
 #include <string_view>
-#include <unordered_map>
 #include <utility>
 #include <vector>
 
 // #include <fmt/core.h>
 
 #include "lib/io.h"
+#include "lib/memo.h"
 #include "lib/parse.h"
 #include "lib/run.h"
 
@@ -20,17 +19,13 @@ struct Towels {
   std::vector<std::string> designs;
 };
 
-std::vector<std::string> readFile(const std::string& path) {
-  return split(read(path), "\n\n", true);
-}
-
 Towels parse(const std::string& path) {
-  auto patternsDesignsStrs = readFile(path);
-  assert(patternsDesignsStrs.size() == 2);
+  const auto file = readMapped(path);
+  const auto [patternsStr, designsStr] = splitToPair(split<"\n\n", true>(file.view()));
 
   const Towels towels = {
-      .patterns = split(std::move(patternsDesignsStrs[0]), ", "),
-      .designs = split(std::move(patternsDesignsStrs[1]), "\n"),
+      .patterns = splitTo<std::vector<std::string>>(split<", ">(patternsStr)),
+      .designs = splitTo<std::vector<std::string>>(split<"\n">(designsStr)),
   };
 
   // fmt::println("patterns: {}", towels.patterns);
@@ -39,32 +34,35 @@ Towels parse(const std::string& path) {
   return towels;
 }
 
+// Ways to make the suffix of design from offset on, memoised by offset.
 size_t check(std::string_view design,
-             std::unordered_map<std::string_view, size_t>& cache,
+             size_t offset,
+             Memo<size_t, size_t>& cache,
              const std::vector<std::string>& patterns) {
-  if (const auto it = cache.find(design); it != cache.end()) {
-    return it->second;
+  if (offset == design.size()) {
+    return 1;
   }
 
-  size_t possible = 0;
-  for (const auto& pattern : patterns) {
-    if (design.starts_with(pattern)) {
-      possible += check(design.substr(pattern.size()), cache, patterns);
+  return cache.get(offset, [&] {
+    const auto suffix = design.substr(offset);
+    size_t possible = 0;
+    for (const auto& pattern : patterns) {
+      if (suffix.starts_with(pattern)) {
+        possible += check(design, offset + pattern.size(), cache, patterns);
+      }
     }
-  }
-
-  assert(cache.count(design) == 0);
-  cache.emplace(design, possible);
-  return possible;
+    return possible;
+  });
 }
 
 size_t count(const std::string& path, bool single = true) {
   const auto towels = parse(path);
 
-  std::unordered_map<std::string_view, size_t> cache = {{"", 1}};
+  Memo<size_t, size_t> cache{};
   return std::accumulate(towels.designs.begin(), towels.designs.end(), 0UL,
                          [&towels, &cache, &single](const auto& sum, const auto& design) {
-                           const auto possible = check(design, cache, towels.patterns);
+                           cache.clear();
+                           const auto possible = check(design, 0, cache, towels.patterns);
                            // fmt::println("{} {}", design, possible);
                            return sum + (single ? (possible > 0) : possible);
                          });
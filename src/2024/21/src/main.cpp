@@ -3,6 +3,7 @@
 #include <algorithm>
 #include <cassert>
 #include <cstddef>
+#include <cstdint>
 #include <iterator>
 #include <limits>
 #include <map>
@@ -14,6 +15,7 @@
 #include <fmt/format.h>
 
 #include "lib/io.h"
+#include "lib/memo.h"
 #include "lib/parse.h"
 #include "lib/run.h"
 #include "lib/to.h"
@@ -110,57 +112,65 @@ std::vector<std::string> pathsBetween(const std::vector<std::string>& grid,
   return paths;
 }
 
-size_t shortestPathLayer(char a,
-                         char b,
-                         size_t layer,
-                         std::map<std::pair<std::pair<char, char>, size_t>, size_t>& cache,
-                         const Keypads& kp) {
+// Going from button a to b on the keypad of layer. Buttons are ASCII characters, so a move packs
+// into one word.
+struct Move final {
+  char a;
+  char b;
+  size_t layer;
+};
+
+struct PackMove final {
+  uint64_t operator()(const Move& move) const {
+    return (uint64_t{static_cast<unsigned char>(move.a)} << 56) |
+           (uint64_t{static_cast<unsigned char>(move.b)} << 48) | move.layer;
+  }
+};
+
+using Cache = Memo<Move, size_t, PackMove>;
+
+size_t shortestPathLayer(char a, char b, size_t layer, Cache& cache, const Keypads& kp) {
   if (layer == (kp.dirpads + 1)) {
     return 1;  // press upper layer button
   }
 
-  const std::pair<std::pair<char, char>, size_t> key = {{a, b}, layer};
-  if (cache.contains(key)) {
-    return cache[key];
-  }
+  return cache.get({.a = a, .b = b, .layer = layer}, [&] {
+    size_t shortestPath = std::numeric_limits<size_t>::max();
+    const auto paths =
+        (layer == 0 ? pathsBetween(kp.numpad, kp.digits.at(a), kp.digits.at(b))
+                    : pathsBetween(kp.dirpad, kp.directions.at(a), kp.directions.at(b)));
 
-  size_t shortestPath = std::numeric_limits<size_t>::max();
-  const auto paths =
-      (layer == 0 ? pathsBetween(kp.numpad, kp.digits.at(a), kp.digits.at(b))
-                  : pathsBetween(kp.dirpad, kp.directions.at(a), kp.directions.at(b)));
+    for (const auto& path : paths) {
+      size_t sum = shortestPathLayer('A', path[0], layer + 1, cache, kp);
 
-  for (const auto& path : paths) {
-    size_t sum = shortestPathLayer('A', path[0], layer + 1, cache, kp);
+      for (size_t i = 0; i < path.size() - 1; ++i) {
+        sum += shortestPathLayer(path[i], path[i + 1], layer + 1, cache, kp);
+      }
 
-    for (size_t i = 0; i < path.size() - 1; ++i) {
-      sum += shortestPathLayer(path[i], path[i + 1], layer + 1, cache, kp);
+      shortestPath = std::min(shortestPath, sum);
     }
 
-    shortestPath = std::min(shortestPath, sum);
-  }
-
-  cache[key] = shortestPath;
-  return shortestPath;
-}
-
-size_t shortestPathLayer(char a, char b, size_t layer, const Keypads& kp) {
-  std::map<std::pair<std::pair<char, char>, size_t>, size_t> cache;
-  return shortestPathLayer(a, b, layer, cache, kp);
+    return shortestPath;
+  });
 }
 
-size_t shortestPathCode(const std::string& code, const Keypads& kp) {
-  size_t sum = shortestPathLayer('A', code[0], 0, kp);
+size_t shortestPathCode(const std::string& code, Cache& cache, const Keypads& kp) {
+  size_t sum = shortestPathLayer('A', code[0], 0, cache, kp);
   for (size_t i = 0; i < code.size() - 1; ++i) {
-    sum += shortestPathLayer(code[i], code[i + 1], 0, kp);
+    sum += shortestPathLayer(code[i], code[i + 1], 0, cache, kp);
   }
 
   return sum;
 }
 
 size_t shortestPathCodes(const std::vector<std::string>& codes, const Keypads& kp) {
-  return std::accumulate(codes.begin(), codes.end(), 0UL, [&kp](const auto& sum, const auto& code) {
-    return sum + shortestPathCode(code, kp) * to<size_t>(code.substr(0, 3));
-  });
+  // Moves cost the same whichever code they are part of.
+  Cache cache{};
+  return std::accumulate(codes.begin(), codes.end(), 0UL,
+                         [&cache, &kp](const auto& sum, const auto& code) {
+                           return sum + shortestPathCode(code, cache, kp) *
+                                            to<size_t>(code.substr(0, 3));
+                         });
 }
 
 size_t complexity(const std::string& path, size_t dirpads) {
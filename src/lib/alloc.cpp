@@ -0,0 +1,432 @@
+#include "lib/alloc.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <cxxabi.h>
+#include <execinfo.h>
+
+#include <fmt/format.h>
+
+#include "lib/io.h"
+
+#ifdef __clang__
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wunsafe-buffer-usage"
+#endif
+
+namespace {
+
+constexpr size_t kDepth = 8;
+constexpr size_t kMaxSites = 1024;
+constexpr size_t kTopSites = 5;
+
+struct Site final {
+  std::array<void*, kDepth> frames;
+  size_t samples;
+  size_t bytes;
+};
+
+// Constant initialized, so it is usable by allocations made before main().
+struct Profile final {
+  std::atomic<size_t> allocations{0};
+  std::atomic<size_t> frees{0};
+  std::atomic<size_t> bytes{0};
+  std::atomic<int64_t> live{0};
+  std::atomic<int64_t> peak{0};
+  std::mutex sitesMutex{};
+  std::array<Site, kMaxSites> sites{};
+  std::atomic<uint32_t> generation{0};
+  std::atomic<bool> recording{false};
+  uint8_t _reserved[3]{};
+};
+
+constinit Profile profile{};
+
+// Demangled function of a backtrace_symbols() line, "binary(symbol+0x1f) [0x...]", or the line
+// itself if the symbol is not exported.
+std::string symbolize(const char* line) {
+  const std::string_view view{line};
+  const auto open = view.find('(');
+  const auto plus = view.find('+', open);
+  if (open == std::string_view::npos || plus == std::string_view::npos || plus == open + 1) {
+    return std::string{view};
+  }
+
+  const std::string mangled{view.substr(open + 1, plus - open - 1)};
+  int status = 0;
+  const std::unique_ptr<char, decltype(&std::free)> demangled{
+      abi::__cxa_demangle(mangled.c_str(), nullptr, nullptr, &status), &std::free};
+  return (status == 0) ? std::string{demangled.get()} : mangled;
+}
+
+// The first frame of a site that is not inside the standard library, which is where the
+// allocation was asked for.
+std::string siteName(const Site& site) {
+  const auto depth = static_cast<size_t>(
+      std::find(site.frames.begin(), site.frames.end(), nullptr) - site.frames.begin());
+  if (depth == 0) {
+    return "<unknown>";
+  }
+
+  const std::unique_ptr<char*, decltype(&std::free)> lines{
+      backtrace_symbols(site.frames.data(), static_cast<int>(depth)), &std::free};
+  if (!lines) {
+    return "<unknown>";
+  }
+
+  std::vector<std::string> names{};
+  for (size_t i = 0; i < depth; ++i) {
+    names.emplace_back(symbolize(lines.get()[i]));
+  }
+
+  for (const auto& name : names) {
+    if (!name.starts_with("std::") && !name.starts_with("__gnu_cxx::") &&
+        !name.starts_with("operator new")) {
+      return name;
+    }
+  }
+
+  return names.front();
+}
+
+}  // namespace
+
+bool allocProfilingEnabled() {
+  static const auto enabled = hasFlag("--alloc", "AOC_ALLOC");
+  return enabled;
+}
+
+bool allocProfilerBuilt() {
+#ifdef AOC_ALLOC_PROFILE
+  return true;
+#else
+  return false;
+#endif
+}
+
+std::string formatBytes(double bytes) {
+  if (bytes >= 1 << 30) {
+    return fmt::format("{:.2f}GiB", bytes / (1 << 30));
+  }
+  if (bytes >= 1 << 20) {
+    return fmt::format("{:.2f}MiB", bytes / (1 << 20));
+  }
+  if (bytes >= 1 << 10) {
+    return fmt::format("{:.2f}KiB", bytes / (1 << 10));
+  }
+  return fmt::format("{:.0f}B", bytes);
+}
+
+void startAllocProfile() {
+  // backtrace() loads the unwinder on first use; do that before anything is counted.
+  std::array<void*, 1> warmup{};
+  backtrace(warmup.data(), 1);
+
+  {
+    const std::lock_guard lock{profile.sitesMutex};
+    profile.sites.fill(Site{});
+  }
+
+  profile.allocations.store(0, std::memory_order_relaxed);
+  profile.frees.store(0, std::memory_order_relaxed);
+  profile.bytes.store(0, std::memory_order_relaxed);
+  profile.live.store(0, std::memory_order_relaxed);
+  profile.peak.store(0, std::memory_order_relaxed);
+  profile.generation.fetch_add(1, std::memory_order_relaxed);
+  profile.recording.store(true, std::memory_order_release);
+}
+
+AllocStats stopAllocProfile() {
+  profile.recording.store(false, std::memory_order_release);
+
+  return {
+      .allocations = profile.allocations.load(std::memory_order_relaxed),
+      .frees = profile.frees.load(std::memory_order_relaxed),
+      .bytes = profile.bytes.load(std::memory_order_relaxed),
+      .peakBytes = static_cast<size_t>(profile.peak.load(std::memory_order_relaxed)),
+  };
+}
+
+void reportAllocs(const std::string& file,
+                  size_t line,
+                  size_t part,
+                  bool example,
+                  const AllocStats& stats) {
+  if (!allocProfilerBuilt()) {
+    fmt::print("{}({}) part {:d} {:<8} allocation profile unavailable, build with make "
+               "ALLOC_PROFILE=true\n",
+               file, line, part, (example ? "example:" : "input:"));
+    return;
+  }
+
+  fmt::print("{}({}) part {:d} {:<8} allocations {} frees {} bytes {} peak {}\n", file, line, part,
+             (example ? "example:" : "input:"), stats.allocations, stats.frees,
+             formatBytes(static_cast<double>(stats.bytes)),
+             formatBytes(static_cast<double>(stats.peakBytes)));
+
+  std::vector<Site> sites{};
+  {
+    const std::lock_guard lock{profile.sitesMutex};
+    std::copy_if(profile.sites.begin(), profile.sites.end(), std::back_inserter(sites),
+                 [](const Site& site) { return site.samples > 0; });
+  }
+
+  // Stacks differing only above the allocating function (e.g. recursion depth) are one site.
+  std::map<std::string, std::pair<size_t, size_t>> named{};
+  for (const auto& site : sites) {
+    auto& [samples, bytes] = named[siteName(site)];
+    samples += site.samples;
+    bytes += site.bytes;
+  }
+
+  std::vector<std::pair<std::string, std::pair<size_t, size_t>>> top{named.begin(), named.end()};
+  std::sort(top.begin(), top.end(),
+            [](const auto& lhs, const auto& rhs) { return lhs.second.second > rhs.second.second; });
+  top.resize(std::min(top.size(), kTopSites));
+
+  for (const auto& [name, totals] : top) {
+    const auto& [samples, bytes] = totals;
+    fmt::print("  ~{:>10} allocations ~{:>10}  {}\n", samples * kSampleEvery,
+               formatBytes(static_cast<double>(bytes * kSampleEvery)), name);
+  }
+}
+
+#ifdef AOC_ALLOC_PROFILE
+
+namespace {
+
+// Frames above the allocating code: sample(), recordAlloc() and the operator new itself.
+constexpr size_t kSkipFrames = 3;
+
+// Every block starts with a header right below the pointer operator new returns: the size asked
+// for, the distance back to what malloc returned, and the generation of the profile that counted
+// the block, 0 if none did. Frees only take from the live bytes of the profile that counted them.
+struct Header final {
+  size_t size;
+  uint32_t offset;
+  uint32_t generation;
+};
+
+// Set while sampling, so that anything the unwinder allocates is not sampled recursively.
+thread_local bool sampling = false;
+thread_local size_t countdown = kSampleEvery;
+
+size_t hashFrames(const std::array<void*, kDepth>& frames) {
+  size_t hash = 14695981039346656037ULL;
+  for (const auto* frame : frames) {
+    hash = (hash ^ reinterpret_cast<uintptr_t>(frame)) * 1099511628211ULL;
+  }
+  return hash;
+}
+
+[[gnu::noinline]] void sample(size_t size) {
+  std::array<void*, kDepth + kSkipFrames> trace{};
+  const auto depth = static_cast<size_t>(backtrace(trace.data(), static_cast<int>(trace.size())));
+
+  std::array<void*, kDepth> frames{};
+  if (depth > kSkipFrames) {
+    std::copy(trace.begin() + kSkipFrames, trace.begin() + static_cast<ptrdiff_t>(depth),
+              frames.begin());
+  }
+
+  const std::lock_guard lock{profile.sitesMutex};
+  const auto hash = hashFrames(frames);
+  for (size_t probe = 0; probe < kMaxSites; ++probe) {
+    auto& site = profile.sites[(hash + probe) % kMaxSites];
+    if (site.samples == 0) {
+      site.frames = frames;
+    } else if (site.frames != frames) {
+      continue;
+    }
+    ++site.samples;
+    site.bytes += size;
+    return;
+  }
+}
+
+[[gnu::noinline]] void recordAlloc(Header& header) {
+  const auto size = header.size;
+  header.generation = profile.generation.load(std::memory_order_relaxed);
+  profile.allocations.fetch_add(1, std::memory_order_relaxed);
+  profile.bytes.fetch_add(size, std::memory_order_relaxed);
+
+  const auto live =
+      profile.live.fetch_add(static_cast<int64_t>(size), std::memory_order_relaxed) +
+      static_cast<int64_t>(size);
+  auto peak = profile.peak.load(std::memory_order_relaxed);
+  while (live > peak &&
+         !profile.peak.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {
+  }
+
+  if (--countdown == 0) {
+    countdown = kSampleEvery;
+    if (!sampling) {
+      sampling = true;
+      sample(size);
+      sampling = false;
+    }
+  }
+}
+
+void recordFree(const Header& header) {
+  profile.frees.fetch_add(1, std::memory_order_relaxed);
+  // Blocks from before the part were never added to live.
+  if (header.generation == profile.generation.load(std::memory_order_relaxed)) {
+    profile.live.fetch_sub(static_cast<int64_t>(header.size), std::memory_order_relaxed);
+  }
+}
+
+constexpr size_t kDefaultAlignment = alignof(std::max_align_t);
+
+static_assert(sizeof(Header) <= kDefaultAlignment);
+
+// Inlined into every operator new, so that backtraces have a fixed number of frames to skip.
+[[gnu::always_inline]] inline void* allocate(size_t size, size_t alignment) {
+  // The header takes a whole alignment in front of the block, so the block stays aligned.
+  alignment = std::max(alignment, kDefaultAlignment);
+
+  // aligned_alloc wants a multiple of the alignment.
+  const auto total = (((std::max<size_t>(size, 1) + alignment - 1) / alignment) + 1) * alignment;
+
+  while (true) {
+    void* block = (alignment == kDefaultAlignment) ? std::malloc(total)
+                                                   : std::aligned_alloc(alignment, total);
+
+    if (block != nullptr) {
+      auto* ptr = static_cast<char*>(block) + alignment;
+      auto* header = new (ptr - sizeof(Header))
+          Header{.size = size, .offset = static_cast<uint32_t>(alignment), .generation = 0};
+      if (profile.recording.load(std::memory_order_relaxed)) {
+        recordAlloc(*header);
+      }
+      return ptr;
+    }
+
+    if (const auto handler = std::get_new_handler()) {
+      handler();
+    } else {
+      throw std::bad_alloc{};
+    }
+  }
+}
+
+void* allocate(size_t size, size_t alignment, const std::nothrow_t&) noexcept {
+  try {
+    return allocate(size, alignment);
+  } catch (...) {
+    return nullptr;
+  }
+}
+
+void deallocate(void* ptr) noexcept {
+  if (ptr == nullptr) {
+    return;
+  }
+  const auto* header = static_cast<const Header*>(ptr) - 1;
+  if (profile.recording.load(std::memory_order_relaxed)) {
+    recordFree(*header);
+  }
+  std::free(static_cast<char*>(ptr) - header->offset);
+}
+
+}  // namespace
+
+void* operator new(size_t size) {
+  return allocate(size, kDefaultAlignment);
+}
+
+void* operator new[](size_t size) {
+  return allocate(size, kDefaultAlignment);
+}
+
+void* operator new(size_t size, const std::nothrow_t& tag) noexcept {
+  return allocate(size, kDefaultAlignment, tag);
+}
+
+void* operator new[](size_t size, const std::nothrow_t& tag) noexcept {
+  return allocate(size, kDefaultAlignment, tag);
+}
+
+void* operator new(size_t size, std::align_val_t alignment) {
+  return allocate(size, static_cast<size_t>(alignment));
+}
+
+void* operator new[](size_t size, std::align_val_t alignment) {
+  return allocate(size, static_cast<size_t>(alignment));
+}
+
+void* operator new(size_t size, std::align_val_t alignment, const std::nothrow_t& tag) noexcept {
+  return allocate(size, static_cast<size_t>(alignment), tag);
+}
+
+void* operator new[](size_t size, std::align_val_t alignment, const std::nothrow_t& tag) noexcept {
+  return allocate(size, static_cast<size_t>(alignment), tag);
+}
+
+void operator delete(void* ptr) noexcept {
+  deallocate(ptr);
+}
+
+void operator delete[](void* ptr) noexcept {
+  deallocate(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept {
+  deallocate(ptr);
+}
+
+void operator delete[](void* ptr, size_t) noexcept {
+  deallocate(ptr);
+}
+
+void operator delete(void* ptr, std::align_val_t) noexcept {
+  deallocate(ptr);
+}
+
+void operator delete[](void* ptr, std::align_val_t) noexcept {
+  deallocate(ptr);
+}
+
+void operator delete(void* ptr, size_t, std::align_val_t) noexcept {
+  deallocate(ptr);
+}
+
+void operator delete[](void* ptr, size_t, std::align_val_t) noexcept {
+  deallocate(ptr);
+}
+
+void operator delete(void* ptr, const std::nothrow_t&) noexcept {
+  deallocate(ptr);
+}
+
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept {
+  deallocate(ptr);
+}
+
+void operator delete(void* ptr, std::align_val_t, const std::nothrow_t&) noexcept {
+  deallocate(ptr);
+}
+
+void operator delete[](void* ptr, std::align_val_t, const std::nothrow_t&) noexcept {
+  deallocate(ptr);
+}
+
+#endif
+
+#ifdef __clang__
+#pragma clang diagnostic pop
+#endif
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+// Allocation profiler backed by a replacement of the global operator new/delete (see alloc.cpp).
+// The replacement is only built with -DAOC_ALLOC_PROFILE, which `make ALLOC_PROFILE=true` passes
+// along with -rdynamic so that call sites have names; other builds keep the standard operators.
+// Enabled with --alloc on the command line or AOC_ALLOC=1, in which case run() reports per part
+// the number of allocations, the bytes requested, the peak of live heap bytes over the part and the
+// call sites that allocated the most, sampled from one in every kSampleEvery allocations. When not
+// profiling, operator new costs one relaxed load on top of malloc.
+struct AllocStats final {
+  size_t allocations;
+  size_t frees;
+  size_t bytes;      // as requested
+  size_t peakBytes;  // peak of bytes allocated during the part and not yet freed
+};
+
+constexpr size_t kSampleEvery = 64;
+
+bool allocProfilingEnabled();
+
+// Whether this binary was built with the replacement operators, without which nothing is counted.
+bool allocProfilerBuilt();
+
+// Human readable size in binary units, e.g. "1.25MiB".
+std::string formatBytes(double bytes);
+
+// Resets the counters and sampled sites, and starts counting on all threads.
+void startAllocProfile();
+AllocStats stopAllocProfile();
+
+// Prints stats and the top allocation sites sampled since startAllocProfile().
+void reportAllocs(const std::string& file,
+                  size_t line,
+                  size_t part,
+                  bool example,
+                  const AllocStats& stats);
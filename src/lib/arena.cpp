@@ -0,0 +1,13 @@
+#include "lib/arena.h"
+
+#include <cstddef>
+#include <memory>
+
+Arena::Arena(size_t initialSize)
+    : buffer_{std::make_unique_for_overwrite<std::byte[]>(initialSize)},
+      resource_{buffer_.get(), initialSize} {}
+
+Arena& runArena() {
+  thread_local Arena arena{};
+  return arena;
+}
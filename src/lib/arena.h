@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+
+// Monotonic arena for the parse phase: allocations are carved out of a few large blocks,
+// deallocation is a no-op and release() frees everything in one shot. The first block is owned by
+// the arena and reused after release(), so a released arena does not go back to the heap until it
+// outgrows initialSize again. Pass resource() to the
+// std::pmr overloads of split(), splitTo() and to().
+class Arena final {
+ public:
+  explicit Arena(size_t initialSize = 1UL << 20);
+
+  Arena(const Arena&) = delete;
+  Arena& operator=(const Arena&) = delete;
+
+  std::pmr::memory_resource* resource() { return &resource_; }
+
+  // Invalidates everything allocated from resource().
+  void release() { resource_.release(); }
+
+ private:
+  std::unique_ptr<std::byte[]> buffer_;
+  std::pmr::monotonic_buffer_resource resource_;
+};
+
+// Arena for the current run() call, one per thread. run() releases it once the part returns, so
+// nothing allocated from it may outlive the part's function.
+Arena& runArena();
@@ -0,0 +1,163 @@
+#include "lib/bench.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <stdexcept>
+#include <string_view>
+
+#include <fmt/format.h>
+
+#include "lib/io.h"
+#include "lib/to.h"
+
+namespace {
+
+constexpr size_t kDefaultRepetitions = 10;
+
+size_t parseRepetitions(std::string_view value) {
+  return value.empty() ? kDefaultRepetitions : to<size_t>(value);
+}
+
+BenchOptions parseOptions() {
+  BenchOptions options{.repetitions = 0, .warmups = 0, .jsonPath = {}};
+
+  if (const auto* env = std::getenv("AOC_BENCH")) {
+    options.repetitions = parseRepetitions(env);
+  }
+  if (const auto* env = std::getenv("AOC_BENCH_JSON")) {
+    options.jsonPath = env;
+  }
+
+  for (const auto& arg : commandLine()) {
+    const std::string_view view{arg};
+    if (view == "--bench") {
+      options.repetitions = kDefaultRepetitions;
+    } else if (view.starts_with("--bench=")) {
+      options.repetitions = parseRepetitions(view.substr(8));
+    } else if (view.starts_with("--bench-json=")) {
+      options.jsonPath = view.substr(13);
+    }
+  }
+
+  options.warmups = (options.repetitions > 0) ? std::max(1UL, options.repetitions / 10) : 0;
+  return options;
+}
+
+std::string formatSummary(const BenchSummary& summary) {
+  return fmt::format("min {} median {} p90 {} p99 {}", formatDuration(summary.min),
+                     formatDuration(summary.median), formatDuration(summary.p90),
+                     formatDuration(summary.p99));
+}
+
+std::string jsonSummary(const BenchSummary& summary) {
+  return fmt::format(R"({{"min":{:.0f},"median":{:.0f},"p90":{:.0f},"p99":{:.0f}}})", summary.min,
+                     summary.median, summary.p90, summary.p99);
+}
+
+std::string jsonEscape(std::string_view str) {
+  std::string escaped{};
+  for (const auto c : str) {
+    if (c == '"' || c == '\\') {
+      escaped += '\\';
+      escaped += c;
+    } else if (static_cast<unsigned char>(c) < 0x20) {
+      // JSON strings take no raw control characters.
+      escaped += fmt::format("\\u{:04x}", static_cast<unsigned char>(c));
+    } else {
+      escaped += c;
+    }
+  }
+  return escaped;
+}
+
+}  // namespace
+
+std::string formatDuration(double nanos) {
+  if (nanos < 1e3) {
+    return fmt::format("{:.0f}ns", nanos);
+  }
+  if (nanos < 1e6) {
+    return fmt::format("{:.2f}us", nanos / 1e3);
+  }
+  if (nanos < 1e9) {
+    return fmt::format("{:.2f}ms", nanos / 1e6);
+  }
+  return fmt::format("{:.3f}s", nanos / 1e9);
+}
+
+const BenchOptions& benchOptions() {
+  static const auto options = parseOptions();
+  return options;
+}
+
+BenchSummary summarize(std::vector<double> samples) {
+  if (samples.empty()) {
+    throw std::invalid_argument("Can not summarize an empty set of samples");
+  }
+
+  std::sort(samples.begin(), samples.end());
+  const auto size = samples.size();
+
+  const auto percentile = [&samples, size](double p) {
+    const auto rank = static_cast<size_t>(std::ceil(p * static_cast<double>(size)));
+    return samples[std::clamp(rank, 1UL, size) - 1];
+  };
+
+  const auto median = (size % 2 == 1) ? samples[size / 2]
+                                      : ((samples[(size / 2) - 1] + samples[size / 2]) / 2);
+
+  return {
+      .min = samples.front(),
+      .median = median,
+      .p90 = percentile(0.9),
+      .p99 = percentile(0.99),
+  };
+}
+
+double wallNanos() {
+  return std::chrono::duration<double, std::nano>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+double cpuNanos() {
+  timespec ts{};
+  clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+  return (static_cast<double>(ts.tv_sec) * 1e9) + static_cast<double>(ts.tv_nsec);
+}
+
+void reportBench(const std::string& file,
+                 size_t line,
+                 size_t part,
+                 bool example,
+                 const std::vector<double>& wallSamples,
+                 const std::vector<double>& cpuSamples) {
+  const auto wall = summarize(wallSamples);
+  const auto cpu = summarize(cpuSamples);
+
+  fmt::print("{}({}) part {:d} {:<8} n={} wall {}\n", file, line, part,
+             (example ? "example:" : "input:"), wallSamples.size(), formatSummary(wall));
+  fmt::print("{}({}) part {:d} {:<8} n={} cpu  {}\n", file, line, part,
+             (example ? "example:" : "input:"), cpuSamples.size(), formatSummary(cpu));
+
+  const auto json = fmt::format(
+      R"({{"file":"{}","line":{},"part":{},"input":"{}","repetitions":{},)"
+      R"("wall_ns":{},"cpu_ns":{}}})",
+      jsonEscape(file), line, part, (example ? "example" : "input"), wallSamples.size(),
+      jsonSummary(wall), jsonSummary(cpu));
+
+  const auto& path = benchOptions().jsonPath;
+  if (path.empty()) {
+    fmt::print("{}\n", json);
+  } else {
+    std::ofstream out{path, std::ios::app};
+    if (!out) {
+      throw std::runtime_error(fmt::format("Failed to open '{}'", path));
+    }
+    out << json << '\n';
+  }
+}
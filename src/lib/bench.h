@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// Benchmark mode of run(), enabled with --bench[=N] on the command line or AOC_BENCH=N in the
+// environment. Every part is then warmed up and repeated N times (10 if not given) after its
+// checked run, and wall and CPU time statistics are printed below the result. The same statistics
+// are written as one JSON object per line to --bench-json=<path> (or AOC_BENCH_JSON) if given,
+// otherwise to stdout right after the human readable line.
+struct BenchOptions final {
+  size_t repetitions;  // 0 when benchmark mode is off
+  size_t warmups;
+  std::string jsonPath;
+};
+
+const BenchOptions& benchOptions();
+
+struct BenchSummary final {
+  double min;
+  double median;
+  double p90;
+  double p99;
+};
+
+// Nearest rank percentiles, except for the median, which averages the middle pair.
+BenchSummary summarize(std::vector<double> samples);
+
+// Monotonic wall clock and process CPU time (all threads), in nanoseconds.
+double wallNanos();
+double cpuNanos();
+
+// Human readable duration with a unit that keeps 3-4 significant digits, e.g. "1.25ms".
+std::string formatDuration(double nanos);
+
+void reportBench(const std::string& file,
+                 size_t line,
+                 size_t part,
+                 bool example,
+                 const std::vector<double>& wallSamples,
+                 const std::vector<double>& cpuSamples);
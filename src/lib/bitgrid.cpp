@@ -0,0 +1,247 @@
+#include "lib/bitgrid.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <span>
+#include <stdexcept>
+
+#include <fmt/format.h>
+
+#ifdef __clang__
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wunsafe-buffer-usage"
+#endif
+
+namespace {
+
+constexpr size_t kWordBits = BitGrid::kWordBits;
+
+uint64_t reverseBits(uint64_t w) {
+  w = ((w >> 1) & 0x5555555555555555ULL) | ((w & 0x5555555555555555ULL) << 1);
+  w = ((w >> 2) & 0x3333333333333333ULL) | ((w & 0x3333333333333333ULL) << 2);
+  w = ((w >> 4) & 0x0F0F0F0F0F0F0F0FULL) | ((w & 0x0F0F0F0F0F0F0F0FULL) << 4);
+  return __builtin_bswap64(w);
+}
+
+// Moves the bits of words by n places, towards the higher bits if n is positive. The words are
+// one little endian bit string: bit i of word k is bit (64 * k) + i.
+void shiftWords(std::span<uint64_t> words, ptrdiff_t n) {
+  const auto size = words.size();
+  const auto distance = static_cast<size_t>((n < 0) ? -n : n);
+  const auto wordShift = distance / kWordBits;
+  const auto bitShift = distance % kWordBits;
+
+  if (wordShift >= size) {
+    std::fill(words.begin(), words.end(), 0);
+    return;
+  }
+
+  if (n > 0) {
+    for (size_t k = size; k-- > wordShift;) {
+      const auto low = (bitShift != 0 && k > wordShift)
+                           ? (words[k - wordShift - 1] >> (kWordBits - bitShift))
+                           : 0;
+      words[k] = (words[k - wordShift] << bitShift) | low;
+    }
+    std::fill_n(words.begin(), wordShift, 0);
+  } else if (n < 0) {
+    for (size_t k = 0; k + wordShift < size; ++k) {
+      const auto high = (bitShift != 0 && k + wordShift + 1 < size)
+                            ? (words[k + wordShift + 1] << (kWordBits - bitShift))
+                            : 0;
+      words[k] = (words[k + wordShift] >> bitShift) | high;
+    }
+    std::fill(words.end() - static_cast<ptrdiff_t>(wordShift), words.end(), 0);
+  }
+}
+
+// Clears the bits at and above bit columns.
+void keepBits(std::span<uint64_t> words, size_t columns) {
+  for (size_t k = 0; k < words.size(); ++k) {
+    const auto first = k * kWordBits;
+    if (first >= columns) {
+      words[k] = 0;
+    } else if (columns - first < kWordBits) {
+      words[k] &= (uint64_t{1} << (columns - first)) - 1;
+    }
+  }
+}
+
+}  // namespace
+
+BitGrid::BitGrid(size_t width, size_t height)
+    : width_(width),
+      height_(height),
+      wordsPerRow_((width + kWordBits - 1) / kWordBits),
+      words_(wordsPerRow_ * height, 0) {}
+
+size_t BitGrid::count(size_t y) const {
+  const auto words = row(y);
+  return std::accumulate(words.begin(), words.end(), size_t{0}, [](size_t sum, uint64_t w) {
+    return sum + static_cast<size_t>(std::popcount(w));
+  });
+}
+
+size_t BitGrid::count() const {
+  return std::accumulate(words_.begin(), words_.end(), size_t{0}, [](size_t sum, uint64_t w) {
+    return sum + static_cast<size_t>(std::popcount(w));
+  });
+}
+
+bool BitGrid::any() const {
+  return std::any_of(words_.begin(), words_.end(), [](uint64_t w) { return w != 0; });
+}
+
+void BitGrid::clear() {
+  std::fill(words_.begin(), words_.end(), 0);
+}
+
+void BitGrid::shiftRow(size_t y, ptrdiff_t n) {
+  const auto words = mutableRow(y);
+  shiftWords(words, n);
+  keepBits(words, width_);
+}
+
+BitGrid BitGrid::shifted(ptrdiff_t dx, ptrdiff_t dy) const {
+  BitGrid result{width_, height_};
+  for (size_t y = 0; y < height_; ++y) {
+    const auto from = y - static_cast<size_t>(dy);
+    if (from < height_) {
+      const auto words = result.mutableRow(y);
+      std::copy_n(row(from).begin(), wordsPerRow_, words.begin());
+      shiftWords(words, dx);
+      keepBits(words, width_);
+    }
+  }
+  return result;
+}
+
+BitGrid BitGrid::reflectedX() const {
+  BitGrid result{width_, height_};
+  for (size_t y = 0; y < height_; ++y) {
+    const auto from = row(y);
+    const auto words = result.mutableRow(y);
+    std::transform(from.rbegin(), from.rend(), words.begin(), reverseBits);
+    // Reversed, cell x of a row of whole words lands at (wordsPerRow * 64) - 1 - x.
+    shiftWords(words, -static_cast<ptrdiff_t>((wordsPerRow_ * kWordBits) - width_));
+  }
+  return result;
+}
+
+BitGrid BitGrid::reflectedY() const {
+  BitGrid result{width_, height_};
+  for (size_t y = 0; y < height_; ++y) {
+    std::copy_n(row(height_ - 1 - y).begin(), wordsPerRow_, result.mutableRow(y).begin());
+  }
+  return result;
+}
+
+BitGrid BitGrid::transposed() const {
+  BitGrid result{height_, width_};
+  forEachSet([&result](size_t x, size_t y) { result.set(y, x); });
+  return result;
+}
+
+BitGrid BitGrid::foldedX(size_t x) const {
+  const auto width = std::max(x, width_ - x - 1);
+
+  // Cell x - d and x + d both land on width - d.
+  auto left = *this;
+  left.keepColumns(x);
+  auto right = reflectedX();
+  right.keepColumns(width_ - x - 1);
+
+  const auto folded = left.shifted(static_cast<ptrdiff_t>(width - x), 0) |
+                      right.shifted(static_cast<ptrdiff_t>(width + x + 1 - width_), 0);
+  return folded.resized(width, height_);
+}
+
+BitGrid BitGrid::foldedY(size_t y) const {
+  const auto height = std::max(y, height_ - y - 1);
+
+  BitGrid result{width_, height};
+  for (size_t from = 0; from < height_; ++from) {
+    if (from == y) {
+      continue;
+    }
+    // Row y - d and y + d both land on height - d.
+    const auto to = (from < y) ? (height - y + from) : (height - (from - y));
+    const auto words = result.mutableRow(to);
+    std::transform(words.begin(), words.end(), row(from).begin(), words.begin(),
+                   [](uint64_t lhs, uint64_t rhs) { return lhs | rhs; });
+  }
+  return result;
+}
+
+BitGrid& BitGrid::operator|=(const BitGrid& other) {
+  checkSameSize(other);
+  std::transform(words_.begin(), words_.end(), other.words_.begin(), words_.begin(),
+                 [](uint64_t lhs, uint64_t rhs) { return lhs | rhs; });
+  return *this;
+}
+
+BitGrid& BitGrid::operator&=(const BitGrid& other) {
+  checkSameSize(other);
+  std::transform(words_.begin(), words_.end(), other.words_.begin(), words_.begin(),
+                 [](uint64_t lhs, uint64_t rhs) { return lhs & rhs; });
+  return *this;
+}
+
+BitGrid& BitGrid::operator^=(const BitGrid& other) {
+  checkSameSize(other);
+  std::transform(words_.begin(), words_.end(), other.words_.begin(), words_.begin(),
+                 [](uint64_t lhs, uint64_t rhs) { return lhs ^ rhs; });
+  return *this;
+}
+
+BitGrid& BitGrid::andNot(const BitGrid& other) {
+  checkSameSize(other);
+  std::transform(words_.begin(), words_.end(), other.words_.begin(), words_.begin(),
+                 [](uint64_t lhs, uint64_t rhs) { return lhs & ~rhs; });
+  return *this;
+}
+
+void BitGrid::keepColumns(size_t columns) {
+  for (size_t y = 0; y < height_; ++y) {
+    keepBits(mutableRow(y), columns);
+  }
+}
+
+BitGrid BitGrid::resized(size_t width, size_t height) const {
+  BitGrid result{width, height};
+  for (size_t y = 0; y < std::min(height, height_); ++y) {
+    const auto words = result.mutableRow(y);
+    std::copy_n(row(y).begin(), std::min(wordsPerRow_, result.wordsPerRow_), words.begin());
+    keepBits(words, width);
+  }
+  return result;
+}
+
+void BitGrid::checkSameSize(const BitGrid& other) const {
+  if (width_ != other.width_ || height_ != other.height_) {
+    throw std::invalid_argument(fmt::format("Bit grids of {}x{} and {}x{} cells do not match",
+                                            width_, height_, other.width_, other.height_));
+  }
+}
+
+BitGrid operator|(BitGrid lhs, const BitGrid& rhs) {
+  lhs |= rhs;
+  return lhs;
+}
+
+BitGrid operator&(BitGrid lhs, const BitGrid& rhs) {
+  lhs &= rhs;
+  return lhs;
+}
+
+BitGrid operator^(BitGrid lhs, const BitGrid& rhs) {
+  lhs ^= rhs;
+  return lhs;
+}
+
+#ifdef __clang__
+#pragma clang diagnostic pop
+#endif
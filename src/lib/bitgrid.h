@@ -0,0 +1,127 @@
+#pragma once
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#ifdef __clang__
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wunsafe-buffer-usage"
+#endif
+
+// Grid of bits, e.g. visited sets and obstacle maps, with every row in its own run of 64-bit words.
+// Bits past the width of a row are always zero, so whole-grid operations (|=, &=, ^=, count(),
+// shifted()) work a word, i.e. 64 cells, at a time, e.g. the cells next to a region are
+//
+//   auto around = region.shifted(1, 0) | region.shifted(-1, 0) | region.shifted(0, 1) |
+//                 region.shifted(0, -1);
+//   around.andNot(region);
+class BitGrid final {
+ public:
+  static constexpr size_t kWordBits = 64;
+
+  explicit BitGrid(size_t width = 0, size_t height = 0);
+
+  size_t width() const { return width_; }
+  size_t height() const { return height_; }
+  size_t wordsPerRow() const { return wordsPerRow_; }
+
+  // Signed coordinates wrap around to huge values, so one unsigned compare per axis suffices.
+  bool contains(size_t x, size_t y) const { return x < width_ && y < height_; }
+
+  bool test(size_t x, size_t y) const { return (word(x, y) & bit(x)) != 0; }
+  void set(size_t x, size_t y) { word(x, y) |= bit(x); }
+  void reset(size_t x, size_t y) { word(x, y) &= ~bit(x); }
+
+  // Sets the cell and returns whether it was set before, for visited checks.
+  bool testAndSet(size_t x, size_t y) {
+    auto& w = word(x, y);
+    const bool was = (w & bit(x)) != 0;
+    w |= bit(x);
+    return was;
+  }
+
+  // Words of row y, cell x in bit x % 64 of word x / 64.
+  std::span<const uint64_t> row(size_t y) const {
+    return std::span<const uint64_t>{words_}.subspan(y * wordsPerRow_, wordsPerRow_);
+  }
+
+  // Number of set cells, in row y or in the whole grid.
+  size_t count(size_t y) const;
+  size_t count() const;
+
+  bool any() const;
+  void clear();
+
+  // Moves row y by n cells, towards higher x if n is positive; cells moved past either end are
+  // dropped and the vacated ones cleared.
+  void shiftRow(size_t y, ptrdiff_t n);
+
+  // This grid moved by (dx, dy), clipped to the same size.
+  BitGrid shifted(ptrdiff_t dx, ptrdiff_t dy) const;
+
+  // Mirrored left to right, top to bottom, and along the main diagonal (width and height swap).
+  BitGrid reflectedX() const;
+  BitGrid reflectedY() const;
+  BitGrid transposed() const;
+
+  // Folds the part right of column x (below row y) over onto the part left of (above) it, e.g. the
+  // transparent paper of adventofcode.com/2021/day/13. The fold line itself is dropped, and the
+  // result is as wide (high) as the larger of the two parts.
+  BitGrid foldedX(size_t x) const;
+  BitGrid foldedY(size_t y) const;
+
+  // Grids must be the same size; throw std::invalid_argument otherwise.
+  BitGrid& operator|=(const BitGrid& other);
+  BitGrid& operator&=(const BitGrid& other);
+  BitGrid& operator^=(const BitGrid& other);
+  BitGrid& andNot(const BitGrid& other);
+
+  bool operator==(const BitGrid& other) const = default;
+
+  // Calls fn(x, y) for every set cell, row by row.
+  template <class Fn>
+  void forEachSet(const Fn& fn) const {
+    for (size_t y = 0; y < height_; ++y) {
+      const auto words = row(y);
+      for (size_t i = 0; i < wordsPerRow_; ++i) {
+        for (auto w = words[i]; w != 0; w &= w - 1) {
+          fn((i * kWordBits) + static_cast<size_t>(std::countr_zero(w)), y);
+        }
+      }
+    }
+  }
+
+ private:
+  static uint64_t bit(size_t x) { return uint64_t{1} << (x % kWordBits); }
+
+  uint64_t word(size_t x, size_t y) const { return words_[(y * wordsPerRow_) + (x / kWordBits)]; }
+  uint64_t& word(size_t x, size_t y) { return words_[(y * wordsPerRow_) + (x / kWordBits)]; }
+
+  std::span<uint64_t> mutableRow(size_t y) {
+    return std::span<uint64_t>{words_}.subspan(y * wordsPerRow_, wordsPerRow_);
+  }
+
+  // Clears the cells at x >= columns of every row.
+  void keepColumns(size_t columns);
+
+  // Top left width x height cells of this grid.
+  BitGrid resized(size_t width, size_t height) const;
+
+  void checkSameSize(const BitGrid& other) const;
+
+  size_t width_;
+  size_t height_;
+  size_t wordsPerRow_;
+  std::vector<uint64_t> words_;
+};
+
+BitGrid operator|(BitGrid lhs, const BitGrid& rhs);
+BitGrid operator&(BitGrid lhs, const BitGrid& rhs);
+BitGrid operator^(BitGrid lhs, const BitGrid& rhs);
+
+#ifdef __clang__
+#pragma clang diagnostic pop
+#endif
@@ -0,0 +1,157 @@
+#pragma once
+
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+
+#ifdef __clang__
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wunsafe-buffer-usage"
+#endif
+
+namespace chars_detail {
+
+constexpr uint64_t kZeros = 0x3030303030303030ULL;
+
+inline uint64_t load8(const char* p) {
+  uint64_t v{};
+  std::memcpy(&v, p, sizeof(v));
+  return v;
+}
+
+// True if all 8 bytes of a little endian word are ASCII digits.
+constexpr bool isEightDigits(uint64_t v) {
+  constexpr uint64_t kHigh = 0xF0F0F0F0F0F0F0F0ULL;
+  return ((v & kHigh) | (((v + 0x0606060606060606ULL) & kHigh) >> 4)) == 0x3333333333333333ULL;
+}
+
+// Converts 8 ASCII digits (first digit in the lowest byte) with 3 multiplies instead of 8.
+constexpr uint64_t parseEightDigits(uint64_t v) {
+  constexpr uint64_t kMask = 0x000000FF000000FFULL;
+  constexpr uint64_t kMul1 = 100 + (1000000ULL << 32);
+  constexpr uint64_t kMul2 = 1 + (10000ULL << 32);
+
+  v -= kZeros;
+  v = (v * 10) + (v >> 8);
+  return (((v & kMask) * kMul1) + (((v >> 16) & kMask) * kMul2)) >> 32;
+}
+
+constexpr bool isSpace(char c) {
+  return c == ' ' || (c >= '\t' && c <= '\r');
+}
+
+// Parses the digit run at the start of str, 8 digits per step while possible. Returns the number of
+// digits consumed, 0 if there are none or the value does not fit in 64 bits.
+inline size_t parseDigits(std::string_view str, uint64_t& value) {
+  const auto* first = str.data();
+  const auto* last = first + str.size();
+  const auto* p = first;
+  value = 0;
+
+  while ((last - p) >= 8) {
+    const auto v = load8(p);
+    if (!isEightDigits(v)) {
+      break;
+    }
+    value = (value * 100000000) + parseEightDigits(v);
+    p += 8;
+  }
+
+  for (; p != last; ++p) {
+    const auto digit = static_cast<unsigned char>(*p - '0');
+    if (digit > 9) {
+      break;
+    }
+    value = (value * 10) + digit;
+  }
+
+  const auto digits = static_cast<size_t>(p - first);
+
+  // 19 digits always fit, longer runs (or leading zeros) are redone with overflow checks.
+  if (digits > 19) {
+    const auto [ptr, ec] = std::from_chars(first, p, value);
+    if (ec != std::errc{}) {
+      return 0;
+    }
+  }
+
+  return digits;
+}
+
+}  // namespace chars_detail
+
+// Non-throwing, locale independent parse of the number at the start of str, matching the std::sto*
+// functions to<>() used to call: leading whitespace and a sign are accepted, integers are parsed as
+// 64-bit values and then narrowed, and a '-' on an unsigned type wraps around. Returns the number
+// of characters consumed, or 0 (leaving value untouched) if there is no valid number.
+template <class T>
+  requires std::is_arithmetic_v<T>
+size_t fromCharsPrefix(std::string_view str, T& value) {
+  size_t i = 0;
+  while (i < str.size() && chars_detail::isSpace(str[i])) {
+    ++i;
+  }
+
+  bool negative = false;
+  if (i < str.size() && (str[i] == '-' || str[i] == '+')) {
+    negative = (str[i] == '-');
+    ++i;
+  }
+
+  if constexpr (std::is_integral_v<T>) {
+    uint64_t magnitude = 0;
+    const auto digits = chars_detail::parseDigits(str.substr(i), magnitude);
+    if (digits == 0) {
+      return 0;
+    }
+
+    if constexpr (std::is_unsigned_v<T>) {
+      value = static_cast<T>(negative ? (0 - magnitude) : magnitude);
+    } else {
+      constexpr auto kMax = static_cast<uint64_t>(INT64_MAX);
+      if (magnitude > (negative ? (kMax + 1) : kMax)) {
+        return 0;
+      }
+      value = static_cast<T>(negative ? static_cast<int64_t>(0 - magnitude)
+                                      : static_cast<int64_t>(magnitude));
+    }
+
+    return i + digits;
+  } else {
+    // std::from_chars takes a '-' of its own, which would accept e.g. "--5".
+    if (i < str.size() && (str[i] == '-' || str[i] == '+')) {
+      return 0;
+    }
+
+    T parsed{};
+    const auto* first = str.data() + i;
+    const auto [ptr, ec] = std::from_chars(first, str.data() + str.size(), parsed);
+    if (ec != std::errc{}) {
+      return 0;
+    }
+
+    value = negative ? -parsed : parsed;
+    return i + static_cast<size_t>(ptr - first);
+  }
+}
+
+// As fromCharsPrefix(), ignoring any trailing characters.
+template <class T>
+  requires std::is_arithmetic_v<T>
+std::optional<T> fromChars(std::string_view str) {
+  T value{};
+  if (fromCharsPrefix(str, value) == 0) {
+    return std::nullopt;
+  }
+
+  return value;
+}
+
+#ifdef __clang__
+#pragma clang diagnostic pop
+#endif
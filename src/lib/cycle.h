@@ -0,0 +1,88 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// Cycle detection for simulations that end up repeating, e.g. a platform spun a billion times:
+//
+//   const auto period = fastForward(platform, 1000000000, spin, [](const Platform& p) {
+//     return p.hash();
+//   });
+//
+// States are told apart by a 64-bit fingerprint the simulation keeps up to date as it goes,
+// typically a Zobrist hash: the sum or XOR of zobristKey(feature) over the features of the state
+// (e.g. cell * 4 + contents), adjusted by the keys of whatever a step changes rather than rehashed.
+// A fingerprint match is confirmed by comparing the states, so a collision costs one compare but
+// never a wrong answer.
+//
+// Brent's algorithm keeps a single saved state, replaced after steps 1, 3, 7, 15, ..., and compares
+// each new state with it. It finds the period within 2 * max(start, period) + period steps, where
+// start is the first step of the cycle, without storing the states seen.
+
+// Pseudo random key of a feature (splitmix64). XOR keys for sets; add them for multisets, where
+// XOR would cancel out pairs.
+inline uint64_t zobristKey(uint64_t feature) {
+  auto z = (feature + 1) * 0x9E3779B97F4A7C15ULL;
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+  return z ^ (z >> 31);
+}
+
+// Brent's algorithm fed one state at a time. State must be copyable and equality comparable.
+template <class State>
+class CycleFinder final {
+ public:
+  CycleFinder(const State& initial, uint64_t fingerprint)
+      : saved_{initial}, savedFingerprint_{fingerprint} {}
+
+  // Records the state after one more step, and returns the period once it is one seen before, or
+  // 0 until then.
+  size_t next(const State& state, uint64_t fingerprint) {
+    ++steps_;
+    ++distance_;
+    if (fingerprint == savedFingerprint_) {
+      if (state == saved_) {
+        return distance_;
+      }
+      ++collisions_;
+    }
+    if (distance_ == power_) {
+      saved_ = state;
+      savedFingerprint_ = fingerprint;
+      power_ *= 2;
+      distance_ = 0;
+    }
+    return 0;
+  }
+
+  // Steps recorded so far.
+  size_t steps() const { return steps_; }
+
+  // Fingerprints that matched the saved state's while the states differed.
+  size_t collisions() const { return collisions_; }
+
+ private:
+  State saved_;
+  uint64_t savedFingerprint_;
+  size_t power_ = 1;
+  size_t distance_ = 0;
+  size_t steps_ = 0;
+  size_t collisions_ = 0;
+};
+
+// Applies step(state) steps times, but once the states repeat, only as often as the steps left
+// modulo the period. Returns the period, or 0 if the states did not repeat within steps.
+template <class State, class Step, class Fingerprint>
+size_t fastForward(State& state, size_t steps, const Step& step, const Fingerprint& fingerprint) {
+  CycleFinder<State> finder{state, fingerprint(state)};
+  for (size_t done = 1; done <= steps; ++done) {
+    step(state);
+    if (const auto period = finder.next(state, fingerprint(state)); period != 0) {
+      for (auto left = (steps - done) % period; left > 0; --left) {
+        step(state);
+      }
+      return period;
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,234 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include <utility>
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+#ifdef __clang__
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wcast-align"
+#pragma clang diagnostic ignored "-Wunsafe-buffer-usage"
+#endif
+
+// String literal usable as a template argument, e.g. split<"\n\n", true>(str).
+template <size_t N>
+struct FixedString final {
+  constexpr FixedString(const char (&str)[N]) { std::copy_n(str, N, chars.begin()); }
+
+  constexpr std::string_view view() const { return {chars.data(), N - 1}; }
+  constexpr size_t size() const { return N - 1; }
+  constexpr char operator[](size_t i) const { return chars[i]; }
+
+  std::array<char, N> chars{};
+};
+
+// 256-bit membership table for a set of delimiter characters.
+class CharClass final {
+ public:
+  constexpr explicit CharClass(std::string_view chars) {
+    for (const auto ch : chars) {
+      const auto c = static_cast<unsigned char>(ch);
+      bits_[c >> 6] |= (1ULL << (c & 63));
+    }
+  }
+
+  constexpr bool contains(char ch) const {
+    const auto c = static_cast<unsigned char>(ch);
+    return (bits_[c >> 6] >> (c & 63)) & 1;
+  }
+
+ private:
+  std::array<uint64_t, 4> bits_{};
+};
+
+namespace delim_detail {
+
+#if defined(__AVX2__)
+
+using Vec = __m256i;
+using Mask = uint32_t;
+constexpr size_t kWidth = 32;
+
+inline Vec load(const char* p) {
+  return _mm256_loadu_si256(reinterpret_cast<const Vec*>(p));
+}
+
+inline Mask eq(Vec v, char c) {
+  return static_cast<Mask>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, _mm256_set1_epi8(c))));
+}
+
+// '0' <= c <= '9', as an unsigned c - '0' <= 9.
+inline Mask digits(Vec v) {
+  const auto offset = _mm256_sub_epi8(v, _mm256_set1_epi8('0'));
+  const auto clamped = _mm256_min_epu8(offset, _mm256_set1_epi8(9));
+  return static_cast<Mask>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(offset, clamped)));
+}
+
+#elif defined(__SSE2__)
+
+using Vec = __m128i;
+using Mask = uint32_t;
+constexpr size_t kWidth = 16;
+
+inline Vec load(const char* p) {
+  return _mm_loadu_si128(reinterpret_cast<const Vec*>(p));
+}
+
+inline Mask eq(Vec v, char c) {
+  return static_cast<Mask>(_mm_movemask_epi8(_mm_cmpeq_epi8(v, _mm_set1_epi8(c))));
+}
+
+// '0' <= c <= '9', as an unsigned c - '0' <= 9.
+inline Mask digits(Vec v) {
+  const auto offset = _mm_sub_epi8(v, _mm_set1_epi8('0'));
+  const auto clamped = _mm_min_epu8(offset, _mm_set1_epi8(9));
+  return static_cast<Mask>(_mm_movemask_epi8(_mm_cmpeq_epi8(offset, clamped)));
+}
+
+#else
+
+// Portable fallback: one 64-bit word at a time, one mask bit per matching byte.
+using Vec = uint64_t;
+using Mask = uint32_t;
+constexpr size_t kWidth = 8;
+
+inline Vec load(const char* p) {
+  Vec v{};
+  std::memcpy(&v, p, sizeof(v));
+  return v;
+}
+
+inline Mask eq(Vec v, char c) {
+  Mask mask = 0;
+  for (size_t i = 0; i < kWidth; ++i) {
+    mask |= static_cast<Mask>(static_cast<char>(v >> (i * 8)) == c) << i;
+  }
+  return mask;
+}
+
+inline Mask digits(Vec v) {
+  Mask mask = 0;
+  for (size_t i = 0; i < kWidth; ++i) {
+    mask |= static_cast<Mask>(static_cast<unsigned char>((v >> (i * 8)) - '0') <= 9) << i;
+  }
+  return mask;
+}
+
+#endif
+
+template <FixedString delim, size_t... I>
+inline Mask anyOf(Vec v, std::index_sequence<I...>) {
+  return (eq(v, delim[I]) | ...);
+}
+
+}  // namespace delim_detail
+
+// Index of the first character in str[pos:] that is one of delim's characters, or npos. Compares a
+// full vector of input against every delimiter character per step.
+template <FixedString delim>
+size_t findAnyOf(std::string_view str, size_t pos) {
+  static_assert(delim.size() > 0);
+  constexpr CharClass kClass{delim.view()};
+  constexpr auto kWidth = delim_detail::kWidth;
+
+  const auto* data = str.data();
+  const auto size = str.size();
+
+  for (; pos + kWidth <= size; pos += kWidth) {
+    const auto mask = delim_detail::anyOf<delim>(delim_detail::load(data + pos),
+                                                 std::make_index_sequence<delim.size()>{});
+    if (mask) {
+      return pos + static_cast<size_t>(std::countr_zero(mask));
+    }
+  }
+
+  for (; pos < size; ++pos) {
+    if (kClass.contains(data[pos])) {
+      return pos;
+    }
+  }
+
+  return std::string_view::npos;
+}
+
+// Index of the first ASCII digit in str[pos:], or npos. Range compares a full vector per step.
+inline size_t findDigit(std::string_view str, size_t pos) {
+  constexpr auto kWidth = delim_detail::kWidth;
+
+  const auto* data = str.data();
+  const auto size = str.size();
+
+  for (; pos + kWidth <= size; pos += kWidth) {
+    const auto mask = delim_detail::digits(delim_detail::load(data + pos));
+    if (mask) {
+      return pos + static_cast<size_t>(std::countr_zero(mask));
+    }
+  }
+
+  for (; pos < size; ++pos) {
+    if (static_cast<unsigned char>(data[pos] - '0') <= 9) {
+      return pos;
+    }
+  }
+
+  return std::string_view::npos;
+}
+
+// Index of the first character in str[pos:] that is not one of delim's characters, or npos. Runs of
+// delimiters are short, so this stays scalar over the lookup table.
+template <FixedString delim>
+constexpr size_t findNotAnyOf(std::string_view str, size_t pos) {
+  constexpr CharClass kClass{delim.view()};
+
+  for (; pos < str.size(); ++pos) {
+    if (!kClass.contains(str[pos])) {
+      return pos;
+    }
+  }
+
+  return std::string_view::npos;
+}
+
+// Index of the first occurrence of delim in str[pos:], or npos. Filters candidates by comparing the
+// first and last delimiter bytes a vector at a time, then verifies the bytes in between.
+template <FixedString delim>
+size_t findSubstr(std::string_view str, size_t pos) {
+  static_assert(delim.size() > 0);
+  constexpr auto kLen = delim.size();
+  constexpr auto kWidth = delim_detail::kWidth;
+
+  if constexpr (kLen == 1) {
+    return findAnyOf<delim>(str, pos);
+  } else {
+    const auto* data = str.data();
+    const auto size = str.size();
+
+    for (; pos + kLen - 1 + kWidth <= size; pos += kWidth) {
+      auto mask = delim_detail::eq(delim_detail::load(data + pos), delim[0]) &
+                  delim_detail::eq(delim_detail::load(data + pos + kLen - 1), delim[kLen - 1]);
+
+      while (mask) {
+        const auto i = pos + static_cast<size_t>(std::countr_zero(mask));
+        if (std::memcmp(data + i + 1, delim.chars.data() + 1, kLen - 2) == 0) {
+          return i;
+        }
+        mask &= mask - 1;
+      }
+    }
+
+    return str.find(delim.view(), pos);
+  }
+}
+
+#ifdef __clang__
+#pragma clang diagnostic pop
+#endif
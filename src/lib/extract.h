@@ -0,0 +1,148 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "lib/chars.h"
+#include "lib/delim.h"
+
+#ifdef __clang__
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wunsafe-buffer-usage"
+#endif
+
+// Writes every integer found in str to out, skipping whatever noise surrounds them, e.g.
+// "p=0,4 v=3,-3" yields 0, 4, 3, -3. Digit runs are located a vector at a time and converted in
+// place without allocating. For signed T a '-' directly in front of a run negates it (so "1-3"
+// yields 1, -3); unsigned T ignores signs. Runs that do not fit in 64 bits are skipped.
+template <class T, class OutputIt>
+  requires std::is_integral_v<T>
+OutputIt extractInts(std::string_view str, OutputIt out) {
+  for (auto pos = findDigit(str, 0); pos != std::string_view::npos; pos = findDigit(str, pos)) {
+    uint64_t magnitude = 0;
+    const auto digits = chars_detail::parseDigits(str.substr(pos), magnitude);
+
+    if (digits == 0) {
+      while (pos < str.size() && static_cast<unsigned char>(str[pos] - '0') <= 9) {
+        ++pos;
+      }
+      continue;
+    }
+
+    const bool negative = std::is_signed_v<T> && pos > 0 && str[pos - 1] == '-';
+    *out++ = static_cast<T>(negative ? (0 - magnitude) : magnitude);
+    pos += digits;
+  }
+
+  return out;
+}
+
+namespace extract_detail {
+
+// Output iterator for one row of a column-major buffer: the i-th value goes to base[i * stride].
+// Counts every value but only stores the first capacity of them.
+template <class T>
+struct StridedWriter final {
+  StridedWriter& operator*() { return *this; }
+  StridedWriter& operator++() { return *this; }
+  StridedWriter operator++(int) { return *this; }
+
+  StridedWriter& operator=(T value) {
+    if (*count < capacity) {
+      base[*count * stride] = value;
+    }
+    ++*count;
+    return *this;
+  }
+
+  T* base;
+  size_t stride;
+  size_t capacity;
+  size_t* count;
+};
+
+}  // namespace extract_detail
+
+// Integers of a whole file in structure-of-arrays form: one contiguous buffer holding column 0 of
+// every row, then column 1 and so on, so per-field loops run over dense, vectorizable spans.
+template <class T>
+class IntColumns final {
+ public:
+  IntColumns(std::vector<T> data, size_t rows, size_t columns)
+      : data_(std::move(data)), rows_(rows), columns_(columns) {}
+
+  size_t rows() const { return rows_; }
+  size_t columns() const { return columns_; }
+
+  std::span<const T> column(size_t column) const {
+    return std::span<const T>{data_}.subspan(column * rows_, rows_);
+  }
+
+  T operator()(size_t row, size_t column) const { return data_[(column * rows_) + row]; }
+
+ private:
+  std::vector<T> data_;
+  size_t rows_;
+  size_t columns_;
+};
+
+// Batch form of extractInts() for inputs with a fixed number of integers per line, e.g. the 4 per
+// robot of "p=0,4 v=3,-3". Lines without any integers (blank lines, headers) are skipped; any other
+// count throws.
+template <class T>
+  requires std::is_integral_v<T>
+IntColumns<T> extractIntColumns(std::string_view str, size_t columns) {
+  size_t maxRows = 1;
+  for (auto pos = findAnyOf<"\n">(str, 0); pos != std::string_view::npos;
+       pos = findAnyOf<"\n">(str, pos + 1)) {
+    ++maxRows;
+  }
+
+  // Laid out with a stride of maxRows while parsing, compacted once the row count is known.
+  std::vector<T> data(maxRows * columns);
+  size_t rows = 0;
+
+  size_t begin = 0;
+  while (begin <= str.size()) {
+    const auto end = std::min(findAnyOf<"\n">(str, begin), str.size());
+    const auto line = str.substr(begin, end - begin);
+    begin = end + 1;
+
+    size_t count = 0;
+    extractInts<T>(line, extract_detail::StridedWriter<T>{.base = data.data() + rows,
+                                                          .stride = maxRows,
+                                                          .capacity = columns,
+                                                          .count = &count});
+    if (count == 0) {
+      continue;
+    }
+    if (count != columns) {
+      throw std::runtime_error(
+          fmt::format("Expected {} integers, found {} in line '{}'", columns, count, line));
+    }
+    ++rows;
+  }
+
+  if (rows != maxRows) {
+    for (size_t column = 1; column < columns; ++column) {
+      std::copy_n(data.begin() + static_cast<ptrdiff_t>(column * maxRows), rows,
+                  data.begin() + static_cast<ptrdiff_t>(column * rows));
+    }
+    data.resize(rows * columns);
+  }
+
+  return IntColumns<T>{std::move(data), rows, columns};
+}
+
+#ifdef __clang__
+#pragma clang diagnostic pop
+#endif
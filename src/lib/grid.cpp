@@ -0,0 +1,66 @@
+#include "lib/grid.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "lib/io.h"
+
+namespace {
+
+std::vector<std::string_view> rows(std::string_view text) {
+  // A file's last line ends with '\n' too, which does not start another row.
+  if (text.ends_with('\n')) {
+    text.remove_suffix(1);
+  }
+
+  std::vector<std::string_view> lines{};
+  if (text.empty()) {
+    return lines;
+  }
+
+  size_t begin = 0;
+  while (begin <= text.size()) {
+    const auto end = std::min(text.find('\n', begin), text.size());
+    auto line = text.substr(begin, end - begin);
+    if (line.ends_with('\r')) {
+      line.remove_suffix(1);
+    }
+    lines.emplace_back(line);
+    begin = end + 1;
+  }
+
+  return lines;
+}
+
+}  // namespace
+
+CharGrid::CharGrid(std::string_view text, size_t border, char sentinel)
+    : cells_(), width_(0), height_(0), border_(border), stride_(0), moves_() {
+  const auto lines = rows(text);
+
+  height_ = lines.size();
+  width_ = lines.empty() ? 0 : lines.front().size();
+  stride_ = width_ + (2 * border_);
+  moves_ = {0 - stride_, 1, stride_, 0 - size_t{1}};
+
+  cells_.assign(stride_ * (height_ + (2 * border_)), sentinel);
+
+  for (size_t y = 0; y < height_; ++y) {
+    if (lines[y].size() != width_) {
+      throw std::invalid_argument(fmt::format("Grid row {} has {} cells, expected {}", y,
+                                              lines[y].size(), width_));
+    }
+    std::copy(lines[y].begin(), lines[y].end(),
+              cells_.begin() + static_cast<std::ptrdiff_t>(index(0, y)));
+  }
+}
+
+CharGrid readGrid(const std::string& path, size_t border, char sentinel) {
+  return CharGrid{readMapped(path).view(), border, sentinel};
+}
@@ -0,0 +1,303 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <new>
+#include <ranges>
+#include <span>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "lib/phase.h"
+
+#ifdef __clang__
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wunsafe-buffer-usage"
+#endif
+
+// Character grid in one contiguous row-major buffer, surrounded by a border of sentinel cells.
+// Cells are addressed by a flat index and a neighbour is always a constant offset away (see
+// move()), so walks that stop on the sentinel need no bounds checks, e.g.
+//
+//   const auto grid = readGrid(path, 1, '#');
+//   for (auto i = grid.find('^'); grid[i] != '#'; i = grid.move(i, CharGrid::kUp)) { ... }
+class CharGrid final {
+ public:
+  // Clockwise, as indices into the move() offsets.
+  static constexpr size_t kUp = 0;
+  static constexpr size_t kRight = 1;
+  static constexpr size_t kDown = 2;
+  static constexpr size_t kLeft = 3;
+
+  // Rows are separated by '\n', which may also end the last one, and must all have the same length.
+  explicit CharGrid(std::string_view text, size_t border = 1, char sentinel = '#');
+
+  size_t width() const { return width_; }
+  size_t height() const { return height_; }
+  size_t border() const { return border_; }
+  size_t stride() const { return stride_; }
+
+  // Number of cells including the border; flat indices are in [0, size()).
+  size_t size() const { return cells_.size(); }
+
+  size_t index(size_t x, size_t y) const { return ((y + border_) * stride_) + x + border_; }
+  size_t x(size_t index) const { return (index % stride_) - border_; }
+  size_t y(size_t index) const { return (index / stride_) - border_; }
+
+  // True if index is a cell of the original grid rather than of the border.
+  bool inside(size_t index) const { return x(index) < width_ && y(index) < height_; }
+
+  // Index of the neighbour in direction (kUp, kRight, kDown or kLeft). Offsets are stored as
+  // unsigned values that wrap around, so stepping up or left is also a single add.
+  size_t move(size_t index, size_t direction) const { return index + moves_[direction]; }
+
+  char operator[](size_t index) const { return cells_[index]; }
+  char& operator[](size_t index) { return cells_[index]; }
+
+  char at(size_t x, size_t y) const { return cells_[index(x, y)]; }
+  char& at(size_t x, size_t y) { return cells_[index(x, y)]; }
+
+  // Flat index of the first cell equal to c, or npos.
+  size_t find(char c) const { return cells_.find(c); }
+
+  // Row y without its border.
+  std::string_view row(size_t y) const {
+    return std::string_view{cells_}.substr(index(0, y), width_);
+  }
+
+  // All cells, border included, in flat index order.
+  std::string_view cells() const { return cells_; }
+
+ private:
+  std::string cells_;
+  size_t width_;
+  size_t height_;
+  size_t border_;
+  size_t stride_;
+  std::array<size_t, 4> moves_;
+};
+
+CharGrid readGrid(const std::string& path, size_t border = 1, char sentinel = '#');
+
+// Step from a cell to one of its neighbours.
+struct GridOffset final {
+  ptrdiff_t dx;
+  ptrdiff_t dy;
+};
+
+// Neighbours clockwise from up, so kNeighbours4 is indexed like CharGrid's kUp ... kLeft.
+inline constexpr std::array<GridOffset, 4> kNeighbours4{{{0, -1}, {1, 0}, {0, 1}, {-1, 0}}};
+inline constexpr std::array<GridOffset, 8> kNeighbours8{
+    {{0, -1}, {1, -1}, {1, 0}, {1, 1}, {0, 1}, {-1, 1}, {-1, 0}, {-1, -1}}};
+
+namespace grid_detail {
+
+// Calls rowFn(y) for every y in [0, height), in blocks of rows on up to threads threads (0 uses
+// every core). Exceptions are rethrown once all threads have finished.
+template <class RowFn>
+void forEachRow(size_t height, size_t threads, const RowFn& rowFn) {
+  if (threads == 0) {
+    threads = std::max(1U, std::thread::hardware_concurrency());
+  }
+  threads = std::max<size_t>(1, std::min(threads, height));
+
+  const auto block = (height + threads - 1) / threads;
+  std::vector<std::exception_ptr> errors(threads);
+  const auto run = [&](size_t i) {
+    try {
+      for (size_t y = i * block; y < std::min(height, (i + 1) * block); ++y) {
+        rowFn(y);
+      }
+    } catch (...) {
+      errors[i] = std::current_exception();
+    }
+  };
+
+  // The calling thread takes the first block, so single core machines never spawn a thread.
+  WorkerPhases phases{threads};
+  std::vector<std::thread> workers{};
+  for (size_t i = 1; i < threads; ++i) {
+    workers.emplace_back([&run, &phases, i] {
+      run(i);
+      phases.collect(i);
+    });
+  }
+  run(0);
+  for (auto& worker : workers) {
+    worker.join();
+  }
+  phases.merge();
+
+  for (const auto& error : errors) {
+    if (error) {
+      std::rethrow_exception(error);
+    }
+  }
+}
+
+}  // namespace grid_detail
+
+// Dense width x height grid of T in one allocation. Rows start on kAlignment byte boundaries: the
+// stride is rounded up to a whole number of cache lines whenever sizeof(T) divides kAlignment. The
+// cells past the width of a row are padding, set by the constructor and fill() like the others.
+// Strides depend on T, so flat indices only carry over between grids of the same T and width.
+// Neighbours are constant offsets (kNeighbours4, kNeighbours8), so searches walk flat indices:
+//
+//   Grid<size_t> distance{width, height, kUnreached};
+//   for (const auto offset : kNeighbours4) {
+//     if (const auto next = distance.neighbour(x, y, offset); next != Grid<size_t>::npos) { ... }
+//   }
+template <class T>
+  requires std::is_trivially_copyable_v<T>
+class Grid final {
+ public:
+  static constexpr size_t kAlignment = 64;
+  static constexpr size_t npos = static_cast<size_t>(-1);
+
+  Grid() : Grid(0, 0) {}
+
+  Grid(size_t width, size_t height, T value = T{})
+      : width_(width), height_(height), stride_(paddedWidth(width)), cells_(allocate(size())) {
+    std::uninitialized_fill_n(cells_.get(), size(), value);
+  }
+
+  Grid(const Grid& other)
+      : width_(other.width_),
+        height_(other.height_),
+        stride_(other.stride_),
+        cells_(allocate(size())) {
+    std::uninitialized_copy_n(other.cells_.get(), size(), cells_.get());
+  }
+
+  Grid& operator=(const Grid& other) {
+    if (this != &other) {
+      *this = Grid{other};
+    }
+    return *this;
+  }
+
+  // A moved-from grid is left empty, 0x0.
+  Grid(Grid&& other) noexcept
+      : width_(std::exchange(other.width_, 0)),
+        height_(std::exchange(other.height_, 0)),
+        stride_(std::exchange(other.stride_, 0)),
+        cells_(std::move(other.cells_)) {}
+
+  Grid& operator=(Grid&& other) noexcept {
+    if (this != &other) {
+      width_ = std::exchange(other.width_, 0);
+      height_ = std::exchange(other.height_, 0);
+      stride_ = std::exchange(other.stride_, 0);
+      cells_ = std::move(other.cells_);
+    }
+    return *this;
+  }
+  ~Grid() = default;
+
+  size_t width() const { return width_; }
+  size_t height() const { return height_; }
+  size_t stride() const { return stride_; }
+
+  // Number of cells including the padding; flat indices are in [0, size()).
+  size_t size() const { return stride_ * height_; }
+
+  size_t index(size_t x, size_t y) const { return (y * stride_) + x; }
+  size_t x(size_t index) const { return index % stride_; }
+  size_t y(size_t index) const { return index / stride_; }
+
+  // Signed coordinates wrap around to huge values, so one unsigned compare per axis suffices.
+  bool contains(size_t x, size_t y) const { return x < width_ && y < height_; }
+
+  // True if index is a cell of the grid rather than of the padding.
+  bool inside(size_t index) const { return x(index) < width_; }
+
+  // Flat index of the cell offset away from (x, y), or npos if that is outside the grid.
+  size_t neighbour(size_t x, size_t y, GridOffset offset) const {
+    const auto nx = x + static_cast<size_t>(offset.dx);
+    const auto ny = y + static_cast<size_t>(offset.dy);
+    return contains(nx, ny) ? index(nx, ny) : npos;
+  }
+
+  T operator[](size_t index) const { return cells_[index]; }
+  T& operator[](size_t index) { return cells_[index]; }
+
+  T at(size_t x, size_t y) const { return cells_[index(x, y)]; }
+  T& at(size_t x, size_t y) { return cells_[index(x, y)]; }
+
+  // Row y without its padding.
+  std::span<const T> row(size_t y) const { return {cells_.get() + index(0, y), width_}; }
+  std::span<T> row(size_t y) { return {cells_.get() + index(0, y), width_}; }
+
+  // Column x, top to bottom, as a view of references stride apart.
+  auto column(size_t x) const {
+    return std::views::iota(size_t{0}, height_) |
+           std::views::transform([this, x](size_t y) -> const T& { return cells_[index(x, y)]; });
+  }
+  auto column(size_t x) {
+    return std::views::iota(size_t{0}, height_) |
+           std::views::transform([this, x](size_t y) -> T& { return cells_[index(x, y)]; });
+  }
+
+  // All cells, padding included, in flat index order.
+  std::span<const T> cells() const { return {cells_.get(), size()}; }
+  std::span<T> cells() { return {cells_.get(), size()}; }
+
+  void fill(T value) { std::fill_n(cells_.get(), size(), value); }
+
+  // Calls fn(x, y, cell) for every cell, on up to threads threads (0 uses every core), each taking
+  // a block of whole rows. Cells of different rows must not depend on each other.
+  template <class Fn>
+  void forEachCell(const Fn& fn, size_t threads = 0) const {
+    grid_detail::forEachRow(height_, threads, [&](size_t y) {
+      const auto cells = row(y);
+      for (size_t x = 0; x < width_; ++x) {
+        fn(x, y, cells[x]);
+      }
+    });
+  }
+
+  template <class Fn>
+  void forEachCell(const Fn& fn, size_t threads = 0) {
+    grid_detail::forEachRow(height_, threads, [&](size_t y) {
+      const auto cells = row(y);
+      for (size_t x = 0; x < width_; ++x) {
+        fn(x, y, cells[x]);
+      }
+    });
+  }
+
+ private:
+  struct Free final {
+    void operator()(T* cells) const { ::operator delete(cells, std::align_val_t{kAlignment}); }
+  };
+
+  static size_t paddedWidth(size_t width) {
+    if constexpr (kAlignment % sizeof(T) == 0) {
+      constexpr auto kPerLine = kAlignment / sizeof(T);
+      return ((width + kPerLine - 1) / kPerLine) * kPerLine;
+    } else {
+      return width;
+    }
+  }
+
+  static std::unique_ptr<T[], Free> allocate(size_t count) {
+    return std::unique_ptr<T[], Free>{
+        static_cast<T*>(::operator new(count * sizeof(T), std::align_val_t{kAlignment}))};
+  }
+
+  size_t width_;
+  size_t height_;
+  size_t stride_;
+  std::unique_ptr<T[], Free> cells_;
+};
+
+#ifdef __clang__
+#pragma clang diagnostic pop
+#endif
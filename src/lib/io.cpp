@@ -1,21 +1,419 @@
 #include "lib/io.h"
 
+#include <algorithm>
+#include <array>
 #include <cassert>
+#include <cerrno>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
 #include <filesystem>
 #include <fstream>
 #include <iterator>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
 
-#include <boost/algorithm/string/trim.hpp>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <fmt/format.h>
+
+#include "lib/parse.h"
+#include "lib/phase.h"
+
+#ifdef __clang__
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wunsafe-buffer-usage"
+#endif
+
+namespace {
+
+[[noreturn]] void throwErrno(const std::string& what, const std::string& path) {
+  throw std::runtime_error(fmt::format("{} '{}': {}", what, path, std::strerror(errno)));
+}
+
+// Reads everything left in fd, for anything that can not be mapped (pipes, ttys, procfs, ...).
+std::string readAll(int fd, const std::string& path, size_t sizeHint) {
+  std::string data(sizeHint > 0 ? sizeHint : 1UL << 16, '\0');
+  size_t size = 0;
+
+  while (true) {
+    if (size == data.size()) {
+      data.resize(data.size() * 2);
+    }
+
+    const auto n = ::read(fd, data.data() + size, data.size() - size);
+    if (n < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      throwErrno("Failed to read", path);
+    }
+
+    if (n == 0) {
+      break;
+    }
+
+    size += static_cast<size_t>(n);
+  }
+
+  data.resize(size);
+  return data;
+}
+
+// Fills as much of buffer as the file allows, returning the number of bytes read. Short only at end
+// of file.
+size_t readFull(int fd, const std::string& path, std::string& buffer) {
+  size_t size = 0;
+
+  while (size < buffer.size()) {
+    const auto n = ::read(fd, buffer.data() + size, buffer.size() - size);
+    if (n < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      throwErrno("Failed to read", path);
+    }
+
+    if (n == 0) {
+      break;
+    }
+
+    size += static_cast<size_t>(n);
+  }
+
+  return size;
+}
+
+// Reads chunks of a file into two alternating buffers on a background thread, one chunk ahead of
+// the consumer.
+class ChunkReader final {
+ public:
+  ChunkReader(int fd, const std::string& path, size_t chunkSize) : path_{path}, fd_{fd} {
+    for (auto& buffer : buffers_) {
+      buffer.resize(chunkSize);
+    }
+
+    thread_ = std::thread{[this] { run(); }};
+  }
+
+  ~ChunkReader() {
+    {
+      const std::lock_guard lock{mutex_};
+      stop_ = true;
+    }
+    cv_.notify_all();
+    thread_.join();
+  }
+
+  ChunkReader(const ChunkReader&) = delete;
+  ChunkReader& operator=(const ChunkReader&) = delete;
+
+  // Releases the previous chunk back to the reader and waits for the next one. A chunk shorter than
+  // chunkSize is the last one.
+  std::string_view next() {
+    std::unique_lock lock{mutex_};
+    if (holding_) {
+      ++released_;
+      cv_.notify_all();
+    }
+    holding_ = true;
+
+    cv_.wait(lock, [this] { return produced_ > released_; });
+    if (error_) {
+      std::rethrow_exception(error_);
+    }
+
+    const auto slot = released_ % buffers_.size();
+    return std::string_view{buffers_[slot]}.substr(0, sizes_[slot]);
+  }
+
+ private:
+  void run() {
+    for (size_t chunk = 0;; ++chunk) {
+      {
+        std::unique_lock lock{mutex_};
+        cv_.wait(lock, [this, chunk] { return stop_ || chunk <= released_ + 1; });
+        if (stop_) {
+          return;
+        }
+      }
+
+      const auto slot = chunk % buffers_.size();
+      size_t size = 0;
+      std::exception_ptr error{};
+      try {
+        size = readFull(fd_, path_, buffers_[slot]);
+      } catch (...) {
+        error = std::current_exception();
+      }
+
+      {
+        const std::lock_guard lock{mutex_};
+        sizes_[slot] = size;
+        error_ = error;
+        produced_ = chunk + 1;
+      }
+      cv_.notify_all();
+
+      if (error || size < buffers_[slot].size()) {
+        return;
+      }
+    }
+  }
+
+  const std::string& path_;
+  std::array<std::string, 2> buffers_{};
+  std::array<size_t, 2> sizes_{};
+  size_t produced_ = 0;
+  size_t released_ = 0;
+  std::mutex mutex_{};
+  std::condition_variable cv_{};
+  std::exception_ptr error_{};
+  std::thread thread_{};
+  int fd_;
+  bool holding_ = false;
+  bool stop_ = false;
+  uint8_t _reserved[2]{};
+};
+
+thread_local std::string dataDir{};
+
+}  // namespace
+
+void setDataDir(std::string dir) {
+  dataDir = std::move(dir);
+}
+
+std::string resolvePath(const std::string& path) {
+  if (dataDir.empty() || path == "-" || path.starts_with('/')) {
+    return path;
+  }
+  return dataDir + "/" + path;
+}
 
 std::string read(const std::string& path, bool trim) {
-  assert(std::filesystem::exists(path));
-  std::ifstream file{path};
+  AOC_PHASE("read");
+  assert(path == "-" || std::filesystem::exists(resolvePath(path)));
+  const MappedFile file{path, trim};
+  return std::string{file.view()};
+}
+
+MappedFile::MappedFile(const std::string& path, bool trim) {
+  const bool stdIn = (path == "-");
+  const int fd = stdIn ? STDIN_FILENO : ::open(resolvePath(path).c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0) {
+    throwErrno("Failed to open", path);
+  }
+
+  struct stat st{};
+  if (::fstat(fd, &st) != 0) {
+    const auto error = errno;
+    if (!stdIn) {
+      ::close(fd);
+    }
+    errno = error;
+    throwErrno("Failed to stat", path);
+  }
 
-  std::string data = {(std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>()};
+  const auto size = static_cast<size_t>(st.st_size);
+  if (S_ISREG(st.st_mode) && size > 0) {
+    void* map = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (map != MAP_FAILED) {
+      // Hints only, failures (e.g. no THP support for file mappings) are harmless.
+      ::madvise(map, size, MADV_SEQUENTIAL);
+      ::madvise(map, size, MADV_WILLNEED);
+#ifdef MADV_HUGEPAGE
+      ::madvise(map, size, MADV_HUGEPAGE);
+#endif
+      map_ = map;
+      mapSize_ = size;
+      view_ = {static_cast<const char*>(map), size};
+    }
+  }
+
+  if (!mapped()) {
+    try {
+      buffer_ = readAll(fd, path, S_ISREG(st.st_mode) ? size : 0);
+    } catch (...) {
+      if (!stdIn) {
+        ::close(fd);
+      }
+      throw;
+    }
+    view_ = buffer_;
+  }
+
+  // The mapping stays valid after the descriptor is closed.
+  if (!stdIn) {
+    ::close(fd);
+  }
 
   if (trim) {
-    boost::trim(data);
+    view_ = trimView(view_);
   }
+}
 
-  return data;
+MappedFile::~MappedFile() {
+  unmap();
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept {
+  *this = std::move(other);
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+  if (this == &other) {
+    return *this;
+  }
+
+  unmap();
+
+  map_ = std::exchange(other.map_, nullptr);
+  mapSize_ = std::exchange(other.mapSize_, 0);
+
+  if (mapped() || other.view_.empty()) {
+    buffer_.clear();
+    view_ = other.view_;
+  } else {
+    // Moving the buffer may relocate it (small string optimization), so rebase the view.
+    const auto offset = static_cast<size_t>(other.view_.data() - other.buffer_.data());
+    const auto size = other.view_.size();
+    buffer_ = std::move(other.buffer_);
+    view_ = std::string_view{buffer_}.substr(offset, size);
+  }
+
+  other.buffer_.clear();
+  other.view_ = {};
+  return *this;
+}
+
+void MappedFile::unmap() {
+  if (mapped()) {
+    ::munmap(map_, mapSize_);
+    map_ = nullptr;
+    mapSize_ = 0;
+  }
+}
+
+MappedFile readMapped(const std::string& path, bool trim) {
+  AOC_PHASE("read");
+  return MappedFile{path, trim};
+}
+
+void forEachRecord(const std::string& path,
+                   std::string_view delim,
+                   const std::function<void(std::string_view)>& fn,
+                   size_t chunkSize) {
+  assert(!delim.empty());
+  assert(chunkSize > 0);
+
+  const bool stdIn = (path == "-");
+  const int fd = stdIn ? STDIN_FILENO : ::open(resolvePath(path).c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0) {
+    throwErrno("Failed to open", path);
+  }
+  ::posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+
+  const auto closeFd = [&stdIn, &fd]() {
+    if (!stdIn) {
+      ::close(fd);
+    }
+  };
+
+  try {
+    ChunkReader reader{fd, path, chunkSize};
+    std::string carry{};
+
+    for (bool last = false; !last;) {
+      const auto chunk = reader.next();
+      last = chunk.size() < chunkSize;
+      size_t pos = 0;
+
+      // A multi-char delimiter may straddle the boundary between the carry and this chunk.
+      if (const auto overlap = std::min(delim.size() - 1, carry.size()); overlap > 0) {
+        const auto seam = carry.substr(carry.size() - overlap) +
+                          std::string{chunk.substr(0, delim.size() - 1)};
+        if (const auto found = seam.find(delim); found < overlap) {
+          carry.resize(carry.size() - overlap + found);
+          fn(carry);
+          carry.clear();
+          pos = found + delim.size() - overlap;
+        }
+      }
+
+      if (const auto found = chunk.find(delim, pos); !carry.empty() && found != std::string::npos) {
+        carry.append(chunk.substr(pos, found - pos));
+        fn(carry);
+        carry.clear();
+        pos = found + delim.size();
+      }
+
+      if (carry.empty()) {
+        for (auto found = chunk.find(delim, pos); found != std::string::npos;
+             found = chunk.find(delim, pos)) {
+          fn(chunk.substr(pos, found - pos));
+          pos = found + delim.size();
+        }
+      }
+
+      carry.append(chunk.substr(std::min(pos, chunk.size())));
+    }
+
+    const auto record = std::string_view{carry}.substr(
+        0, carry.find_last_not_of(" \t\n\v\f\r") + 1);
+    if (!record.empty()) {
+      fn(record);
+    }
+  } catch (...) {
+    closeFd();
+    throw;
+  }
+
+  closeFd();
+}
+
+void forEachLine(const std::string& path,
+                 const std::function<void(std::string_view)>& fn,
+                 size_t chunkSize) {
+  forEachRecord(path, "\n", fn, chunkSize);
 }
+
+std::vector<std::string> commandLine() {
+  std::ifstream file{"/proc/self/cmdline", std::ios::binary};
+  const std::string cmdline{std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{}};
+
+  std::vector<std::string> args{};
+  size_t begin = 0;
+  while (begin < cmdline.size()) {
+    const auto end = std::min(cmdline.find('\0', begin), cmdline.size());
+    args.emplace_back(cmdline.substr(begin, end - begin));
+    begin = end + 1;
+  }
+
+  if (!args.empty()) {
+    args.erase(args.begin());  // program name
+  }
+
+  return args;
+}
+
+bool hasFlag(std::string_view flag, const char* envVar) {
+  if (const auto* env = std::getenv(envVar); env != nullptr && std::string_view{env} != "0") {
+    return true;
+  }
+
+  const auto args = commandLine();
+  return std::find(args.begin(), args.end(), flag) != args.end();
+}
+
+#ifdef __clang__
+#pragma clang diagnostic pop
+#endif
@@ -1,5 +1,65 @@
 #pragma once
 
+#include <cstddef>
+#include <functional>
 #include <string>
+#include <string_view>
+#include <vector>
+
+// Directory that the relative paths given to the functions below are resolved against on the
+// calling thread; empty (the working directory) by default. Lets aoc-runner run several days, each
+// with its own data/, in one process.
+void setDataDir(std::string dir);
+std::string resolvePath(const std::string& path);
 
 std::string read(const std::string& path, bool trim = true);
+
+// Owning, read-only view of a file's contents. Regular files are mmap'd and parsed straight out of
+// the page cache; pipes, stdin ("-") and other files that can not be mapped fall back to a single
+// read into an owned buffer. Either way view() is trimmed without copying.
+class MappedFile final {
+ public:
+  explicit MappedFile(const std::string& path, bool trim = true);
+  ~MappedFile();
+
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  MappedFile(MappedFile&& other) noexcept;
+  MappedFile& operator=(MappedFile&& other) noexcept;
+
+  std::string_view view() const { return view_; }
+  bool mapped() const { return map_ != nullptr; }
+
+ private:
+  void unmap();
+
+  void* map_ = nullptr;
+  size_t mapSize_ = 0;
+  std::string buffer_{};
+  std::string_view view_{};
+};
+
+MappedFile readMapped(const std::string& path, bool trim = true);
+
+// Streams path (or stdin, "-") through two fixed size buffers and calls fn for every record
+// separated by delim, so memory stays bounded by 2 * chunkSize plus the longest record. The next
+// chunk is read on a background thread while fn processes the current one. Records spanning a
+// chunk boundary are stitched together; the views passed to fn are only valid during the call.
+// Records are passed untrimmed, except the last one, which has trailing whitespace removed and is
+// skipped if that leaves it empty (so a trailing newline does not produce an empty record).
+void forEachRecord(const std::string& path,
+                   std::string_view delim,
+                   const std::function<void(std::string_view)>& fn,
+                   size_t chunkSize = 1UL << 20);
+
+void forEachLine(const std::string& path,
+                 const std::function<void(std::string_view)>& fn,
+                 size_t chunkSize = 1UL << 20);
+
+// Arguments the process was started with, without the program name. Read from /proc/self/cmdline,
+// so library code can look at flags without main() passing argv around.
+std::vector<std::string> commandLine();
+
+// True if flag (e.g. "--phases") is on the command line, or envVar is set to anything but "0".
+bool hasFlag(std::string_view flag, const char* envVar);
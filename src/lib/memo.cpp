@@ -0,0 +1,81 @@
+#include "lib/memo.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "lib/io.h"
+
+namespace {
+
+struct Registry final {
+  std::mutex mutex;
+  std::vector<const memo_detail::Counters*> live;
+  MemoStats retired{.hits = 0, .misses = 0};
+};
+
+// Memo tables may be static, so the registry is built on first use.
+Registry& registry() {
+  static Registry registry{};
+  return registry;
+}
+
+}  // namespace
+
+memo_detail::Counters::Counters() {
+  auto& r = registry();
+  const std::lock_guard lock{r.mutex};
+  r.live.push_back(this);
+}
+
+memo_detail::Counters::~Counters() {
+  auto& r = registry();
+  const std::lock_guard lock{r.mutex};
+  r.retired.hits += hits_;
+  r.retired.misses += misses_;
+  if (const auto it = std::find(r.live.begin(), r.live.end(), this); it != r.live.end()) {
+    *it = r.live.back();
+    r.live.pop_back();
+  }
+}
+
+memo_detail::Counters::Counters(const Counters&) : Counters() {}
+
+memo_detail::Counters& memo_detail::Counters::operator=(const Counters&) {
+  return *this;
+}
+
+bool memoReportEnabled() {
+  static const auto enabled = hasFlag("--memo", "AOC_MEMO");
+  return enabled;
+}
+
+MemoStats memoStats() {
+  auto& r = registry();
+  const std::lock_guard lock{r.mutex};
+  auto stats = r.retired;
+  for (const auto* counters : r.live) {
+    stats.hits += counters->stats().hits;
+    stats.misses += counters->stats().misses;
+  }
+  return stats;
+}
+
+void reportMemo(const std::string& file,
+                size_t line,
+                size_t part,
+                bool example,
+                const MemoStats& before,
+                const MemoStats& after) {
+  const auto hits = after.hits - before.hits;
+  const auto misses = after.misses - before.misses;
+  const auto lookups = hits + misses;
+  fmt::print("{}({}) part {:d} {:<8} memo hits {} misses {} hit rate {:.1f}%\n", file, line, part,
+             (example ? "example:" : "input:"), hits, misses,
+             (lookups > 0) ? (100.0 * static_cast<double>(hits) / static_cast<double>(lookups))
+                           : 0.0);
+}
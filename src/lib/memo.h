@@ -0,0 +1,326 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#if defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+#ifdef __clang__
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wcast-align"
+#pragma clang diagnostic ignored "-Wunsafe-buffer-usage"
+#endif
+
+// Memo tables for recursive dynamic programming, e.g. counting arrangements from a position and a
+// run index:
+//
+//   struct PackState {
+//     uint64_t operator()(const State& s) const { return (uint64_t{s.pos} << 32) | s.run; }
+//   };
+//   Memo<State, size_t, PackState> memo{};
+//   size_t count(State s) { return memo.get(s, [&] { return ... count(next) ... ; }); }
+//
+// The caller packs each key into a distinct 64-bit integer, so the table hashes and compares one
+// word instead of strings or tuples. Slots are in groups with one control byte each, holding 7 bits
+// of the hash or empty, and a lookup matches the control bytes of a whole group at once (16 with
+// SSE2, 8 in a word otherwise) before it looks at a key. Entries are never erased.
+//
+// Every table counts its hits and misses; run() prints their sum per part with --memo or
+// AOC_MEMO=1.
+struct MemoStats final {
+  size_t hits;
+  size_t misses;
+};
+
+// Packs integral keys as themselves.
+template <class Key>
+struct MemoPack final {
+  uint64_t operator()(Key key) const
+    requires std::integral<Key>
+  {
+    return static_cast<uint64_t>(key);
+  }
+};
+
+namespace memo_detail {
+
+// Murmur3's finalizer: every input bit affects the group index and the 7 bit tag.
+inline uint64_t mix(uint64_t x) {
+  x ^= x >> 33;
+  x *= 0xFF51AFD7ED558CCDULL;
+  x ^= x >> 33;
+  x *= 0xC4CEB9FE1A85EC53ULL;
+  x ^= x >> 33;
+  return x;
+}
+
+constexpr uint8_t kEmpty = 0x80;
+
+#if defined(__SSE2__)
+
+constexpr size_t kGroupSize = 16;
+
+// One bit per control byte of the group at p equal to c.
+inline uint32_t match(const uint8_t* p, uint8_t c) {
+  const auto group = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+  return static_cast<uint32_t>(
+      _mm_movemask_epi8(_mm_cmpeq_epi8(group, _mm_set1_epi8(static_cast<char>(c)))));
+}
+
+#else
+
+// Portable fallback: one 64-bit word per group.
+constexpr size_t kGroupSize = 8;
+
+inline uint32_t match(const uint8_t* p, uint8_t c) {
+  uint64_t group{};
+  std::memcpy(&group, p, sizeof(group));
+  uint32_t mask = 0;
+  for (size_t i = 0; i < kGroupSize; ++i) {
+    mask |= static_cast<uint32_t>(static_cast<uint8_t>(group >> (i * 8)) == c) << i;
+  }
+  return mask;
+}
+
+#endif
+
+// Hits and misses of one table. Live counters are registered so memoStats() can add them up;
+// a destroyed one leaves its counts behind. Copies start from zero.
+class Counters final {
+ public:
+  Counters();
+  ~Counters();
+  Counters(const Counters& other);
+  Counters& operator=(const Counters& other);
+
+  void hit() { ++hits_; }
+  void miss() { ++misses_; }
+  MemoStats stats() const { return {.hits = hits_, .misses = misses_}; }
+
+ private:
+  size_t hits_ = 0;
+  size_t misses_ = 0;
+};
+
+}  // namespace memo_detail
+
+bool memoReportEnabled();
+
+// Hits and misses over all tables so far, including destroyed ones.
+MemoStats memoStats();
+
+// Prints the hits and misses between two memoStats().
+void reportMemo(const std::string& file,
+                size_t line,
+                size_t part,
+                bool example,
+                const MemoStats& before,
+                const MemoStats& after);
+
+// Single threaded memo table; Pack must be stateless and map distinct keys to distinct integers.
+template <class Key, class Value, class Pack = MemoPack<Key>>
+class Memo final {
+ public:
+  // Room for capacity entries before the first rehash.
+  explicit Memo(size_t capacity = 0) { allocate(groupsFor(capacity)); }
+
+  // The value stored for key, or nullptr; counts a hit or a miss. The pointer is valid until the
+  // next insert.
+  const Value* find(const Key& key) {
+    const auto packed = Pack{}(key);
+    const auto slot = lookup(packed, memo_detail::mix(packed));
+    if (slot == kNone) {
+      counters_.miss();
+      return nullptr;
+    }
+    counters_.hit();
+    return &values_[slot];
+  }
+
+  // Stores value for key unless it already has one.
+  void insert(const Key& key, const Value& value) {
+    const auto packed = Pack{}(key);
+    const auto hash = memo_detail::mix(packed);
+    if (lookup(packed, hash) != kNone) {
+      return;
+    }
+    if (size_ == growAt_) {
+      rehash(2 * groups());
+    }
+    const auto slot = emptySlot(hash);
+    control_[slot] = tag(hash);
+    keys_[slot] = packed;
+    values_[slot] = value;
+    ++size_;
+  }
+
+  // The value stored for key, or compute() stored and returned. compute may recurse into get().
+  template <class Compute>
+  Value get(const Key& key, const Compute& compute) {
+    if (const auto* value = find(key)) {
+      return *value;
+    }
+    // Recursion may rehash, so the slot is looked up again to insert.
+    const Value value = compute();
+    insert(key, value);
+    return value;
+  }
+
+  size_t size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+  MemoStats stats() const { return counters_.stats(); }
+
+  // Drops every entry but keeps the capacity, and the counts.
+  void clear() {
+    std::fill(control_.begin(), control_.end(), memo_detail::kEmpty);
+    size_ = 0;
+  }
+
+ private:
+  static constexpr size_t kNone = static_cast<size_t>(-1);
+  static constexpr size_t kGroupSize = memo_detail::kGroupSize;
+
+  // Groups are a power of 2, filled to at most 7/8.
+  static size_t groupsFor(size_t capacity) {
+    return std::bit_ceil(std::max<size_t>(1, ((capacity * 8 / 7) + kGroupSize) / kGroupSize));
+  }
+
+  static uint8_t tag(uint64_t hash) { return static_cast<uint8_t>(hash >> 57); }
+
+  size_t groups() const { return control_.size() / kGroupSize; }
+
+  // Groups are probed in triangular steps from the one the low bits of hash pick, which visits
+  // every group.
+  size_t firstGroup(uint64_t hash) const { return hash & (groups() - 1); }
+  size_t nextGroup(size_t group, size_t step) const { return (group + step) & (groups() - 1); }
+
+  // Slot of packed, or kNone. As nothing is erased, a group with an empty slot ends the probe.
+  size_t lookup(uint64_t packed, uint64_t hash) const {
+    const auto wanted = tag(hash);
+    for (size_t group = firstGroup(hash), step = 1;; group = nextGroup(group, step++)) {
+      const auto first = group * kGroupSize;
+      for (auto bits = memo_detail::match(&control_[first], wanted); bits != 0; bits &= bits - 1) {
+        const auto slot = first + static_cast<size_t>(std::countr_zero(bits));
+        if (keys_[slot] == packed) {
+          return slot;
+        }
+      }
+      if (memo_detail::match(&control_[first], memo_detail::kEmpty) != 0) {
+        return kNone;
+      }
+    }
+  }
+
+  size_t emptySlot(uint64_t hash) const {
+    for (size_t group = firstGroup(hash), step = 1;; group = nextGroup(group, step++)) {
+      const auto first = group * kGroupSize;
+      if (const auto bits = memo_detail::match(&control_[first], memo_detail::kEmpty); bits != 0) {
+        return first + static_cast<size_t>(std::countr_zero(bits));
+      }
+    }
+  }
+
+  void allocate(size_t groups) {
+    control_.assign(groups * kGroupSize, memo_detail::kEmpty);
+    keys_.assign(groups * kGroupSize, 0);
+    values_.assign(groups * kGroupSize, Value{});
+    size_ = 0;
+    growAt_ = groups * kGroupSize * 7 / 8;
+  }
+
+  void rehash(size_t groups) {
+    auto control = std::move(control_);
+    auto keys = std::move(keys_);
+    auto values = std::move(values_);
+    const auto size = size_;
+    allocate(groups);
+
+    for (size_t i = 0; i < control.size(); ++i) {
+      if (control[i] != memo_detail::kEmpty) {
+        const auto hash = memo_detail::mix(keys[i]);
+        const auto slot = emptySlot(hash);
+        control_[slot] = tag(hash);
+        keys_[slot] = keys[i];
+        values_[slot] = std::move(values[i]);
+      }
+    }
+    size_ = size;
+  }
+
+  std::vector<uint8_t> control_;
+  std::vector<uint64_t> keys_;
+  std::vector<Value> values_;
+  size_t size_ = 0;
+  size_t growAt_ = 0;
+  memo_detail::Counters counters_{};
+};
+
+// Memo table shared by threads, e.g. a recursion split over mapReduce(). Keys are spread over
+// Shards tables by their hash, each behind its own mutex, so threads only wait for one another on
+// the same shard. compute() runs unlocked: two threads may both compute a missing value, and the
+// first one stored wins.
+template <class Key, class Value, class Pack = MemoPack<Key>, size_t Shards = 64>
+class ShardedMemo final {
+ public:
+  template <class Compute>
+  Value get(const Key& key, const Compute& compute) {
+    auto& shard = shardOf(key);
+    {
+      const std::lock_guard lock{shard.mutex};
+      if (const auto* value = shard.memo.find(key)) {
+        return *value;
+      }
+    }
+    const Value value = compute();
+    const std::lock_guard lock{shard.mutex};
+    shard.memo.insert(key, value);
+    return value;
+  }
+
+  size_t size() {
+    size_t size = 0;
+    for (auto& shard : shards_) {
+      const std::lock_guard lock{shard.mutex};
+      size += shard.memo.size();
+    }
+    return size;
+  }
+
+  MemoStats stats() {
+    MemoStats stats{.hits = 0, .misses = 0};
+    for (auto& shard : shards_) {
+      const std::lock_guard lock{shard.mutex};
+      stats.hits += shard.memo.stats().hits;
+      stats.misses += shard.memo.stats().misses;
+    }
+    return stats;
+  }
+
+ private:
+  struct Shard final {
+    std::mutex mutex;
+    Memo<Key, Value, Pack> memo;
+  };
+
+  // Bits above the ones a shard's table uses for the group.
+  Shard& shardOf(const Key& key) {
+    return shards_[(memo_detail::mix(Pack{}(key)) >> 32) % Shards];
+  }
+
+  std::array<Shard, Shards> shards_;
+};
+
+#ifdef __clang__
+#pragma clang diagnostic pop
+#endif
@@ -0,0 +1,119 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "lib/io.h"
+#include "lib/parse.h"
+#include "lib/phase.h"
+
+namespace parallel_detail {
+
+// Cuts text into at most parts chunks of roughly equal size, each ending on a line boundary.
+inline std::vector<std::string_view> lineChunks(std::string_view text, size_t parts) {
+  std::vector<std::string_view> chunks{};
+  const auto target = (text.size() / parts) + 1;
+
+  size_t begin = 0;
+  while (begin < text.size()) {
+    const auto end = std::min(text.find('\n', std::min(begin + target, text.size())), text.size());
+    chunks.emplace_back(text.substr(begin, end - begin));
+    begin = end + 1;
+  }
+
+  return chunks;
+}
+
+}  // namespace parallel_detail
+
+// Parallel form of mapping every line and folding the results, e.g.
+//
+//   mapReduceText(text, [](std::string_view line) { return solve(parse(line)); }, std::plus<>{});
+//
+// Lines are the tokens of split(text, "\n"): trimmed, with empty lines skipped. text is cut at
+// newlines into one chunk per thread (threads = 0 uses every core); each chunk folds its lines in
+// order, then the partial results are folded in chunk order. The result therefore does not depend
+// on scheduling, only on reduce being associative. Exceptions from map or reduce are rethrown once
+// all threads have finished. An input without lines yields a value initialized result.
+template <class Map,
+          class Reduce,
+          class Result = std::decay_t<std::invoke_result_t<const Map&, std::string_view>>>
+Result mapReduceText(std::string_view text,
+                     const Map& map,
+                     const Reduce& reduce,
+                     size_t threads = 0) {
+  if (threads == 0) {
+    threads = std::max(1U, std::thread::hardware_concurrency());
+  }
+
+  const auto chunks = parallel_detail::lineChunks(text, threads);
+  std::vector<std::optional<Result>> partials(chunks.size());
+  std::vector<std::exception_ptr> errors(chunks.size());
+
+  const auto fold = [&](size_t i) {
+    try {
+      auto& partial = partials[i];
+      for (const auto line : split<"\n">(chunks[i])) {
+        if (line.empty()) {
+          continue;
+        }
+        auto mapped = map(line);
+        partial = partial ? reduce(std::move(*partial), std::move(mapped)) : std::move(mapped);
+      }
+    } catch (...) {
+      errors[i] = std::current_exception();
+    }
+  };
+
+  // The calling thread takes the first chunk, so single core machines never spawn a thread.
+  WorkerPhases phases{chunks.size()};
+  std::vector<std::thread> workers{};
+  for (size_t i = 1; i < chunks.size(); ++i) {
+    workers.emplace_back([&fold, &phases, i] {
+      fold(i);
+      phases.collect(i);
+    });
+  }
+  if (!chunks.empty()) {
+    fold(0);
+  }
+  for (auto& worker : workers) {
+    worker.join();
+  }
+  phases.merge();
+
+  for (const auto& error : errors) {
+    if (error) {
+      std::rethrow_exception(error);
+    }
+  }
+
+  std::optional<Result> result{};
+  for (auto& partial : partials) {
+    if (partial) {
+      result = result ? reduce(std::move(*result), std::move(*partial)) : std::move(*partial);
+    }
+  }
+
+  return result ? std::move(*result) : Result{};
+}
+
+// mapReduceText() over the lines of a file, mapped rather than copied into memory.
+template <class Map,
+          class Reduce,
+          class Result = std::decay_t<std::invoke_result_t<const Map&, std::string_view>>>
+Result mapReduceLines(const std::string& path,
+                      const Map& map,
+                      const Reduce& reduce,
+                      size_t threads = 0) {
+  const auto file = readMapped(path);
+  return mapReduceText<Map, Reduce, Result>(file.view(), map, reduce, threads);
+}
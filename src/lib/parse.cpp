@@ -25,11 +25,14 @@
 #include <boost/regex/v5/regex_traits.hpp>
 #include <boost/regex/v5/regex_traits_defaults.hpp>
 
+#include "lib/phase.h"
+
 std::vector<std::string> split(std::string&& str,
                                const std::string& delim,
                                bool delimMultiChar,
                                bool trimOriginal,
                                bool trimSplit) {
+  AOC_PHASE("split");
   std::vector<std::string> v{};
 
   if (trimOriginal) {
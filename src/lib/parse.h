@@ -1,9 +1,23 @@
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory_resource>
+#include <ranges>
+#include <stdexcept>
 #include <string>
+#include <string_view>
 #include <utility>
 #include <vector>
 
+#include <fmt/format.h>
+
+#include "lib/delim.h"
+#include "lib/phase.h"
 #include "lib/to.h"
 
 // Emulates python's split() function.
@@ -19,6 +33,7 @@ To splitTo(std::string&& str,
            bool delimMultiChar = false,
            bool trimOriginal = true,
            bool trimSplit = true) {
+  AOC_PHASE("splitTo");
   return to<To>(split(std::move(str), delim, delimMultiChar, trimOriginal, trimSplit));
 }
 
@@ -31,3 +46,216 @@ std::pair<Lhs, Rhs> splitToPair(std::string&& str,
   return splitTo<std::pair<Lhs, Rhs>>(std::move(str), delim, delimMultiChar, trimOriginal,
                                       trimSplit);
 }
+
+// Same whitespace set as boost::trim in the default locale.
+constexpr std::string_view trimView(std::string_view str) {
+  constexpr std::string_view kWhitespace = " \t\n\v\f\r";
+
+  const auto first = str.find_first_not_of(kWhitespace);
+  if (first == std::string_view::npos) {
+    return str.substr(str.size());
+  }
+
+  const auto last = str.find_last_not_of(kWhitespace);
+  return str.substr(first, last - first + 1);
+}
+
+// Delimiter given at runtime, as accepted by split().
+struct RuntimeDelim final {
+  constexpr size_t find(std::string_view str, size_t pos) const {
+    return multiChar ? str.find(delim, pos) : str.find_first_of(delim, pos);
+  }
+
+  // Adjacent single char delimiters are compressed, like boost::algorithm::token_compress_on.
+  constexpr size_t skip(std::string_view str, size_t found) const {
+    return multiChar ? (found + delim.size())
+                     : std::min(str.find_first_not_of(delim, found), str.size());
+  }
+
+  std::string_view delim;
+  bool multiChar;
+  uint8_t _reserved[7]{};
+};
+
+// Delimiter fixed at compile time, see split<delim, delimMultiChar>().
+template <FixedString delim, bool delimMultiChar>
+struct StaticDelim final {
+  size_t find(std::string_view str, size_t pos) const {
+    if constexpr (delimMultiChar) {
+      return findSubstr<delim>(str, pos);
+    } else {
+      return findAnyOf<delim>(str, pos);
+    }
+  }
+
+  size_t skip(std::string_view str, size_t found) const {
+    if constexpr (delimMultiChar) {
+      return found + delim.size();
+    } else {
+      return std::min(findNotAnyOf<delim>(str, found), str.size());
+    }
+  }
+};
+
+// Lazy, allocation free counterpart of split(). Yields std::string_view tokens into str, which must
+// outlive the range. Tokens match split() exactly, except that a multi-char delim is matched as a
+// literal substring rather than as a regex.
+template <class Delim>
+class BasicSplitView : public std::ranges::view_interface<BasicSplitView<Delim>> {
+ public:
+  class Iterator final {
+   public:
+    using iterator_concept = std::forward_iterator_tag;
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = std::string_view;
+    using difference_type = std::ptrdiff_t;
+
+    Iterator() = default;
+
+    constexpr explicit Iterator(const BasicSplitView* view) : view_{view} { find(0); }
+
+    constexpr std::string_view operator*() const {
+      const auto token = view_->str_.substr(begin_, end_ - begin_);
+      return view_->trimSplit_ ? trimView(token) : token;
+    }
+
+    constexpr Iterator& operator++() {
+      if (next_ == std::string_view::npos) {
+        view_ = nullptr;
+      } else {
+        find(next_);
+      }
+
+      return *this;
+    }
+
+    constexpr Iterator operator++(int) {
+      auto it = *this;
+      ++*this;
+      return it;
+    }
+
+    constexpr bool operator==(const Iterator& other) const {
+      return view_ == other.view_ && (view_ == nullptr || begin_ == other.begin_);
+    }
+
+    constexpr bool operator==(std::default_sentinel_t) const { return view_ == nullptr; }
+
+   private:
+    constexpr void find(size_t pos) {
+      const auto& str = view_->str_;
+
+      begin_ = pos;
+      const auto found = view_->delim_.find(str, pos);
+
+      if (found == std::string_view::npos) {
+        end_ = str.size();
+        next_ = std::string_view::npos;
+      } else {
+        end_ = found;
+        next_ = view_->delim_.skip(str, found);
+      }
+    }
+
+    const BasicSplitView* view_ = nullptr;
+    size_t begin_ = 0;
+    size_t end_ = 0;
+    size_t next_ = 0;
+  };
+
+  constexpr BasicSplitView(std::string_view str, Delim delim, bool trimOriginal, bool trimSplit)
+      : delim_{delim}, str_{trimOriginal ? trimView(str) : str}, trimSplit_{trimSplit} {}
+
+  constexpr Iterator begin() const { return Iterator{this}; }
+  constexpr std::default_sentinel_t end() const { return {}; }
+
+ private:
+  [[no_unique_address]] Delim delim_;
+  std::string_view str_;
+  bool trimSplit_;
+  uint8_t _reserved[7]{};
+};
+
+class SplitView final : public BasicSplitView<RuntimeDelim> {
+ public:
+  constexpr SplitView(std::string_view str,
+                      std::string_view delim = " ",
+                      bool delimMultiChar = false,
+                      bool trimOriginal = true,
+                      bool trimSplit = true)
+      : BasicSplitView{str, {.delim = delim, .multiChar = delimMultiChar}, trimOriginal,
+                       trimSplit} {}
+};
+
+constexpr SplitView splitView(std::string_view str,
+                              std::string_view delim = " ",
+                              bool delimMultiChar = false,
+                              bool trimOriginal = true,
+                              bool trimSplit = true) {
+  return {str, delim, delimMultiChar, trimOriginal, trimSplit};
+}
+
+// split() with the delimiter compiled in: single chars become a lookup table and vector compares,
+// multi-char delimiters a precomputed substring search. Lazy like splitView().
+template <FixedString delim, bool delimMultiChar = false>
+constexpr BasicSplitView<StaticDelim<delim, delimMultiChar>> split(std::string_view str,
+                                                                   bool trimOriginal = true,
+                                                                   bool trimSplit = true) {
+  return {str, {}, trimOriginal, trimSplit};
+}
+
+template <class Tokens>
+concept TokenRange = std::ranges::input_range<Tokens> &&
+                     std::same_as<std::ranges::range_value_t<Tokens>, std::string_view>;
+
+template <class To, TokenRange Tokens>
+To splitTo(const Tokens& tokens) {
+  To ret{};
+
+  for (const auto token : tokens) {
+    ret.insert(ret.end(), to<typename To::value_type>(token));
+  }
+
+  return ret;
+}
+
+// As splitTo() above, into a std::pmr container allocated from resource (see lib/arena.h).
+template <class To, TokenRange Tokens>
+  requires PmrContainer<To>
+To splitTo(const Tokens& tokens, std::pmr::memory_resource* resource) {
+  return to<To>(tokens, resource);
+}
+
+// split() with the vector and its strings allocated from resource, so the whole result is freed by
+// releasing the arena. Tokens come from splitView(): a multi-char delim is a literal substring.
+inline std::pmr::vector<std::pmr::string> split(std::string_view str,
+                                                 std::pmr::memory_resource* resource,
+                                                 std::string_view delim = " ",
+                                                 bool delimMultiChar = false,
+                                                 bool trimOriginal = true,
+                                                 bool trimSplit = true) {
+  AOC_PHASE("split");
+  return splitTo<std::pmr::vector<std::pmr::string>>(
+      splitView(str, delim, delimMultiChar, trimOriginal, trimSplit), resource);
+}
+
+template <class Lhs = std::string_view, class Rhs = std::string_view, TokenRange Tokens>
+std::pair<Lhs, Rhs> splitToPair(const Tokens& tokens) {
+  std::array<std::string_view, 2> parts = {};
+  size_t size = 0;
+
+  for (const auto token : tokens) {
+    if (size < 2) {
+      parts[size] = token;
+    }
+    ++size;
+  }
+
+  if (size != 2) {
+    throw std::runtime_error(
+        fmt::format("Can not construct pair (size=2) from tokens (actual_size={}): '{}' ", size,
+                    fmt::join(tokens, ",")));
+  }
+
+  return {to<Lhs>(parts[0]), to<Rhs>(parts[1])};
+}
@@ -0,0 +1,192 @@
+#include "lib/perf.h"
+
+#include <cerrno>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <limits>
+
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+#include <fmt/format.h>
+
+#include "lib/io.h"
+
+namespace {
+
+constexpr auto kNaN = std::numeric_limits<double>::quiet_NaN();
+
+struct Event final {
+  uint32_t type;
+  uint8_t _reserved[4]{};
+  uint64_t config;
+  const char* name;
+};
+
+constexpr uint64_t cacheConfig(uint64_t cache, uint64_t op, uint64_t result) {
+  return cache | (op << 8) | (result << 16);
+}
+
+// Indexed like PerfCounts::values.
+const std::array<Event, PerfCounts::kNumEvents> kEvents = {{
+    {.type = PERF_TYPE_HARDWARE, .config = PERF_COUNT_HW_CPU_CYCLES, .name = "cycles"},
+    {.type = PERF_TYPE_HARDWARE, .config = PERF_COUNT_HW_INSTRUCTIONS, .name = "instructions"},
+    {.type = PERF_TYPE_HW_CACHE,
+     .config = cacheConfig(PERF_COUNT_HW_CACHE_L1D, PERF_COUNT_HW_CACHE_OP_READ,
+                           PERF_COUNT_HW_CACHE_RESULT_MISS),
+     .name = "L1D misses"},
+    {.type = PERF_TYPE_HARDWARE, .config = PERF_COUNT_HW_CACHE_MISSES, .name = "LLC misses"},
+    {.type = PERF_TYPE_HARDWARE, .config = PERF_COUNT_HW_BRANCH_MISSES, .name = "branch misses"},
+}};
+
+int openEvent(const Event& event, int groupFd) {
+  perf_event_attr attr{};
+  attr.size = sizeof(attr);
+  attr.type = event.type;
+  attr.config = event.config;
+  attr.disabled = (groupFd < 0) ? 1 : 0;
+  attr.inherit = 1;
+  attr.exclude_kernel = 1;
+  attr.exclude_hv = 1;
+  attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+  return static_cast<int>(
+      syscall(SYS_perf_event_open, &attr, 0, -1, groupFd, PERF_FLAG_FD_CLOEXEC));
+}
+
+std::string paranoidLevel() {
+  std::ifstream file{"/proc/sys/kernel/perf_event_paranoid"};
+  std::string level{};
+  file >> level;
+  return level.empty() ? "unknown" : level;
+}
+
+// Counter value scaled by enabled / running time, NaN if the counter never ran.
+double readEvent(int fd) {
+  struct {
+    uint64_t value;
+    uint64_t enabled;
+    uint64_t running;
+  } data{};
+
+  if (::read(fd, &data, sizeof(data)) != static_cast<ssize_t>(sizeof(data)) || data.running == 0) {
+    return kNaN;
+  }
+
+  return static_cast<double>(data.value) * static_cast<double>(data.enabled) /
+         static_cast<double>(data.running);
+}
+
+std::string formatCount(double count) {
+  if (std::isnan(count)) {
+    return "n/a";
+  }
+  if (count >= 1e9) {
+    return fmt::format("{:.2f}G", count / 1e9);
+  }
+  if (count >= 1e6) {
+    return fmt::format("{:.2f}M", count / 1e6);
+  }
+  if (count >= 1e3) {
+    return fmt::format("{:.2f}K", count / 1e3);
+  }
+  return fmt::format("{:.0f}", count);
+}
+
+std::string formatRatio(double ratio) {
+  return std::isfinite(ratio) ? fmt::format("{:.2f}", ratio) : "n/a";
+}
+
+}  // namespace
+
+PerfCounters::PerfCounters() : fds_{} {
+  fds_.fill(-1);
+
+  fds_[PerfCounts::kCycles] = openEvent(kEvents[PerfCounts::kCycles], -1);
+  if (fds_[PerfCounts::kCycles] < 0) {
+    error_ = fmt::format("perf_event_open failed: {} (perf_event_paranoid={})",
+                         std::strerror(errno), paranoidLevel());
+    return;
+  }
+
+  // Any other event may be missing on this CPU or hypervisor; it is then reported as n/a.
+  for (size_t i = 1; i < fds_.size(); ++i) {
+    fds_[i] = openEvent(kEvents[i], fds_[PerfCounts::kCycles]);
+  }
+}
+
+PerfCounters::~PerfCounters() {
+  for (const auto fd : fds_) {
+    if (fd >= 0) {
+      ::close(fd);
+    }
+  }
+}
+
+void PerfCounters::start() {
+  if (!available()) {
+    return;
+  }
+
+  ioctl(fds_[PerfCounts::kCycles], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+  ioctl(fds_[PerfCounts::kCycles], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+}
+
+PerfCounts PerfCounters::stop() {
+  PerfCounts counts{};
+  counts.values.fill(kNaN);
+
+  if (!available()) {
+    return counts;
+  }
+
+  ioctl(fds_[PerfCounts::kCycles], PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+  for (size_t i = 0; i < fds_.size(); ++i) {
+    if (fds_[i] >= 0) {
+      counts.values[i] = readEvent(fds_[i]);
+    }
+  }
+
+  return counts;
+}
+
+bool perfEnabled() {
+  static const auto enabled = hasFlag("--perf", "AOC_PERF");
+  return enabled;
+}
+
+PerfCounters& perfCounters() {
+  static PerfCounters counters{};
+  return counters;
+}
+
+void reportPerf(const std::string& file,
+                size_t line,
+                size_t part,
+                bool example,
+                const PerfCounts& counts) {
+  const auto* input = example ? "example:" : "input:";
+
+  if (!perfCounters().available()) {
+    static bool reported = false;
+    if (!reported) {
+      fmt::print("{}({}) part {:d} {:<8} perf counters unavailable, {}\n", file, line, part, input,
+                 perfCounters().error());
+      reported = true;
+    }
+    return;
+  }
+
+  const auto& v = counts.values;
+  fmt::print(
+      "{}({}) part {:d} {:<8} cycles {} instructions {} IPC {} | MPKI L1D {} LLC {} branch {}\n",
+      file, line, part, input, formatCount(v[PerfCounts::kCycles]),
+      formatCount(v[PerfCounts::kInstructions]), formatRatio(counts.ipc()),
+      formatRatio(counts.mpki(PerfCounts::kL1dMisses)),
+      formatRatio(counts.mpki(PerfCounts::kLlcMisses)),
+      formatRatio(counts.mpki(PerfCounts::kBranchMisses)));
+}
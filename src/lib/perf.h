@@ -0,0 +1,64 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Hardware counters of one measured region. Events the kernel or CPU does not support (common in
+// VMs) are NaN.
+struct PerfCounts final {
+  static constexpr size_t kCycles = 0;
+  static constexpr size_t kInstructions = 1;
+  static constexpr size_t kL1dMisses = 2;
+  static constexpr size_t kLlcMisses = 3;
+  static constexpr size_t kBranchMisses = 4;
+  static constexpr size_t kNumEvents = 5;
+
+  // Instructions per cycle.
+  double ipc() const { return values[kInstructions] / values[kCycles]; }
+
+  // Misses per kilo-instruction of one of the miss events.
+  double mpki(size_t event) const { return 1000 * values[event] / values[kInstructions]; }
+
+  std::array<double, kNumEvents> values;
+};
+
+// perf_event group counting cycles, instructions, L1D read misses, LLC misses and branch misses of
+// user space code in the calling thread and the threads it starts while counting. Opening fails
+// gracefully: if perf_event_open is not allowed (see /proc/sys/kernel/perf_event_paranoid) or not
+// supported, available() is false and error() says why.
+class PerfCounters final {
+ public:
+  PerfCounters();
+  ~PerfCounters();
+
+  PerfCounters(const PerfCounters&) = delete;
+  PerfCounters& operator=(const PerfCounters&) = delete;
+
+  bool available() const { return fds_[PerfCounts::kCycles] >= 0; }
+  const std::string& error() const { return error_; }
+
+  // Resets and starts the group; no-op if not available().
+  void start();
+  // Stops the group and reads it, scaled up if the kernel had to multiplex the counters. All NaN if
+  // not available().
+  PerfCounts stop();
+
+ private:
+  std::array<int, PerfCounts::kNumEvents> fds_;
+  uint8_t _reserved[4]{};
+  std::string error_;
+};
+
+// Enabled with --perf on the command line or AOC_PERF=1, in which case run() wraps every part in
+// perfCounters() and prints IPC and misses per kilo-instruction after the result.
+bool perfEnabled();
+PerfCounters& perfCounters();
+
+// Prints counts, or once per process why counters are unavailable.
+void reportPerf(const std::string& file,
+                size_t line,
+                size_t part,
+                bool example,
+                const PerfCounts& counts);
@@ -0,0 +1,121 @@
+#include "lib/phase.h"
+
+#include <algorithm>
+#include <memory>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "lib/io.h"
+
+namespace {
+
+struct Tree final {
+  PhaseNode root{.name = "", .parent = nullptr, .nanos = 0, .calls = 0, .children = {}};
+  PhaseNode* current = &root;
+};
+
+Tree& tree() {
+  thread_local Tree tree{};
+  return tree;
+}
+
+bool sameName(const char* lhs, const char* rhs) {
+  return lhs == rhs || std::string_view{lhs} == rhs;
+}
+
+// Adds phases to the children of into, merging those with the same name.
+void mergeInto(PhaseNode& into, std::vector<std::unique_ptr<PhaseNode>> phases) {
+  for (auto& phase : phases) {
+    const auto it = std::find_if(into.children.begin(), into.children.end(),
+                                 [&phase](const auto& child) {
+                                   return sameName(child->name, phase->name);
+                                 });
+    if (it == into.children.end()) {
+      phase->parent = &into;
+      into.children.emplace_back(std::move(phase));
+    } else {
+      (*it)->nanos += phase->nanos;
+      (*it)->calls += phase->calls;
+      mergeInto(**it, std::move(phase->children));
+    }
+  }
+}
+
+void print(const PhaseNode& node, size_t depth, double totalNanos) {
+  for (const auto& child : node.children) {
+    const auto indent = std::string(2 * depth, ' ');
+    fmt::print("  {}{:<{}} {:>10} {:>6.1f}% {:>8}x\n", indent, child->name, 24 - (2 * depth),
+               formatDuration(child->nanos),
+               (totalNanos > 0) ? (100 * child->nanos / totalNanos) : 0.0, child->calls);
+    print(*child, depth + 1, totalNanos);
+  }
+}
+
+}  // namespace
+
+std::atomic<bool> phase_detail::enabled{hasFlag("--phases", "AOC_PHASES")};
+
+PhaseNode* phase_detail::enter(const char* name) {
+  auto& t = tree();
+
+  for (const auto& child : t.current->children) {
+    if (sameName(child->name, name)) {
+      t.current = child.get();
+      return t.current;
+    }
+  }
+
+  t.current->children.emplace_back(std::make_unique<PhaseNode>(
+      PhaseNode{.name = name, .parent = t.current, .nanos = 0, .calls = 0, .children = {}}));
+  t.current = t.current->children.back().get();
+  return t.current;
+}
+
+void phase_detail::leave(PhaseNode* node, double nanos) {
+  node->nanos += nanos;
+  ++node->calls;
+  tree().current = node->parent;
+}
+
+void enablePhases(bool enable) {
+  phase_detail::enabled.store(enable, std::memory_order_relaxed);
+}
+
+const PhaseNode& phaseTree() {
+  return tree().root;
+}
+
+void resetPhases() {
+  auto& t = tree();
+  t.root.children.clear();
+  t.current = &t.root;
+}
+
+void WorkerPhases::collect(size_t i) {
+  if (phasesEnabled()) {
+    auto& t = tree();
+    trees_[i] = std::move(t.root.children);
+    t.root.children.clear();
+    t.current = &t.root;
+  }
+}
+
+void WorkerPhases::merge() {
+  for (auto& phases : trees_) {
+    mergeInto(*tree().current, std::move(phases));
+    phases.clear();
+  }
+}
+
+void reportPhases(const std::string& file,
+                  size_t line,
+                  size_t part,
+                  bool example,
+                  double totalNanos) {
+  fmt::print("{}({}) part {:d} {:<8} phases, total {}\n", file, line, part,
+             (example ? "example:" : "input:"), formatDuration(totalNanos));
+  print(tree().root, 0, totalNanos);
+}
@@ -0,0 +1,112 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "lib/bench.h"
+
+// Scoped phase timers, e.g.
+//
+//   Input parse(const std::string& path) {
+//     AOC_PHASE("parse");
+//     ...
+//   }
+//
+// Phases nest by scope into a per-thread tree; phases with the same name under the same parent are
+// merged, adding up their time and calls. Recording is off unless the program is started with
+// --phases or AOC_PHASES=1 (or enablePhases() is called), in which case run() prints the tree of
+// the calling thread after each part. The workers of mapReduceText() and forEachRow() hand their
+// trees over to it (see WorkerPhases); phases on any other thread are not reported. Disabled
+// phases cost one relaxed load and a branch; building with -DAOC_NO_PHASES compiles them out
+// entirely.
+struct PhaseNode final {
+  const char* name;
+  PhaseNode* parent;
+  double nanos;
+  size_t calls;
+  std::vector<std::unique_ptr<PhaseNode>> children;
+};
+
+namespace phase_detail {
+
+extern std::atomic<bool> enabled;
+
+PhaseNode* enter(const char* name);
+void leave(PhaseNode* node, double nanos);
+
+}  // namespace phase_detail
+
+inline bool phasesEnabled() {
+  return phase_detail::enabled.load(std::memory_order_relaxed);
+}
+
+void enablePhases(bool enable);
+
+// The calling thread's tree. The root has no name and only serves as parent.
+const PhaseNode& phaseTree();
+
+// Drops everything recorded on the calling thread. Must not be called while a phase is open.
+void resetPhases();
+
+// Trees of worker threads, added to the calling thread's tree under the phase open there once the
+// workers have been joined:
+//
+//   WorkerPhases phases{threads};
+//   workers.emplace_back([&, i] { work(i); phases.collect(i); });  // for i = 1, 2, ...
+//   work(0);
+//   ... join the workers ...
+//   phases.merge();
+//
+// Phases that ran in parallel add up their time, so their shares of a part can exceed 100%.
+class WorkerPhases final {
+ public:
+  explicit WorkerPhases(size_t workers) : trees_(workers) {}
+
+  // Takes what worker i recorded, as its last step.
+  void collect(size_t i);
+
+  // Adds the collected trees to the calling thread's tree.
+  void merge();
+
+ private:
+  std::vector<std::vector<std::unique_ptr<PhaseNode>>> trees_;
+};
+
+// Prints the calling thread's tree, with each phase's share of totalNanos.
+void reportPhases(const std::string& file,
+                  size_t line,
+                  size_t part,
+                  bool example,
+                  double totalNanos);
+
+class Phase final {
+ public:
+  explicit Phase(const char* name)
+      : node_{phasesEnabled() ? phase_detail::enter(name) : nullptr},
+        start_{(node_ != nullptr) ? wallNanos() : 0} {}
+
+  ~Phase() {
+    if (node_ != nullptr) {
+      phase_detail::leave(node_, wallNanos() - start_);
+    }
+  }
+
+  Phase(const Phase&) = delete;
+  Phase& operator=(const Phase&) = delete;
+
+ private:
+  PhaseNode* node_;
+  double start_;
+};
+
+#define AOC_PHASE_CONCAT_(a, b) a##b
+#define AOC_PHASE_CONCAT(a, b) AOC_PHASE_CONCAT_(a, b)
+
+#ifdef AOC_NO_PHASES
+#define AOC_PHASE(name) static_cast<void>(0)
+#else
+#define AOC_PHASE(name) const Phase AOC_PHASE_CONCAT(aocPhase, __LINE__)(name)
+#endif
@@ -0,0 +1,160 @@
+#include "lib/progress.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <string_view>
+#include <utility>
+
+#include <fmt/format.h>
+
+#include "lib/bench.h"
+#include "lib/io.h"
+#include "lib/to.h"
+
+namespace {
+
+std::chrono::nanoseconds parseTimeout() {
+  size_t seconds = 0;
+  if (const auto* env = std::getenv("AOC_TIMEOUT")) {
+    seconds = to<size_t>(std::string_view{env});
+  }
+  for (const auto& arg : commandLine()) {
+    const std::string_view view{arg};
+    if (view.starts_with("--timeout=")) {
+      seconds = to<size_t>(view.substr(10));
+    }
+  }
+  return std::chrono::seconds{seconds};
+}
+
+// Count with an SI suffix, e.g. "12.34M".
+std::string formatCount(double count) {
+  if (count >= 1e9) {
+    return fmt::format("{:.2f}G", count / 1e9);
+  }
+  if (count >= 1e6) {
+    return fmt::format("{:.2f}M", count / 1e6);
+  }
+  if (count >= 1e3) {
+    return fmt::format("{:.2f}k", count / 1e3);
+  }
+  return fmt::format("{:.0f}", count);
+}
+
+double nanos(std::chrono::steady_clock::duration duration) {
+  return static_cast<double>(std::chrono::nanoseconds{duration}.count());
+}
+
+}  // namespace
+
+std::chrono::nanoseconds defaultTimeout() {
+  static const auto timeout = parseTimeout();
+  return timeout;
+}
+
+ProgressMonitor::ProgressMonitor(std::string label,
+                                 std::chrono::nanoseconds timeout,
+                                 std::chrono::milliseconds interval)
+    : label_(std::move(label)),
+      timeout_(timeout),
+      interval_(interval),
+      start_(std::chrono::steady_clock::now()),
+      lastTime_(start_),
+      lastItems_(0),
+      mutex_(),
+      stopped_(),
+      stopping_(false),
+      thread_() {
+  auto& state = progress_detail::state;
+  state.items.store(0, std::memory_order_relaxed);
+  state.total.store(0, std::memory_order_relaxed);
+  state.cancelled.store(false, std::memory_order_relaxed);
+
+  thread_ = std::thread{&ProgressMonitor::watch, this};
+}
+
+ProgressMonitor::~ProgressMonitor() {
+  stop();
+}
+
+void ProgressMonitor::stop() {
+  if (thread_.joinable()) {
+    {
+      const std::lock_guard lock{mutex_};
+      stopping_ = true;
+    }
+    stopped_.notify_one();
+    thread_.join();
+  }
+}
+
+void ProgressMonitor::watch() {
+  const auto deadline = start_ + timeout_;
+
+  std::unique_lock lock{mutex_};
+  while (true) {
+    auto wakeup = std::chrono::steady_clock::now() + interval_;
+    if (timeout_.count() > 0 && !cancelled()) {
+      wakeup = std::min(wakeup, deadline);
+    }
+
+    if (stopped_.wait_until(lock, wakeup, [this] { return stopping_; })) {
+      return;
+    }
+
+    const auto now = std::chrono::steady_clock::now();
+    if (!cancelled() && timeout_.count() > 0 && now >= deadline) {
+      std::fflush(stdout);
+      fmt::print(stderr, "{}: deadline of {} passed, cancelling\n", label_,
+                 formatDuration(nanos(timeout_)));
+      progress_detail::state.cancelled.store(true, std::memory_order_relaxed);
+    } else if (cancelled() && now >= deadline + kCancelGrace) {
+      std::fflush(stdout);
+      fmt::print(stderr, "{}: still running {} after cancellation, exiting\n", label_,
+                 formatDuration(nanos(kCancelGrace)));
+      std::_Exit(EXIT_FAILURE);
+    } else if (now - lastTime_ >= interval_) {
+      report(now);
+    }
+  }
+}
+
+void ProgressMonitor::report(std::chrono::steady_clock::time_point now) {
+  const auto& state = progress_detail::state;
+  const auto items = state.items.load(std::memory_order_relaxed);
+  const auto total = state.total.load(std::memory_order_relaxed);
+
+  // Silent for solvers that do not count their progress.
+  if (items == 0) {
+    return;
+  }
+
+  const auto rate =
+      static_cast<double>(items - lastItems_) * 1e9 / std::max(nanos(now - lastTime_), 1.0);
+  lastItems_ = items;
+  lastTime_ = now;
+
+  std::string eta{};
+  if (total > items && rate > 0) {
+    eta = fmt::format(", ETA {}", formatDuration(static_cast<double>(total - items) * 1e9 / rate));
+  }
+
+  // Keeps the results printed so far ahead of progress when both go to a terminal.
+  std::fflush(stdout);
+  fmt::print(stderr, "{}: {}{} items, {} items/s{}\n", label_,
+             formatCount(static_cast<double>(items)),
+             (total > 0) ? fmt::format(" / {}", formatCount(static_cast<double>(total))) : "",
+             formatCount(rate), eta);
+}
+
+void reportCancelled(const std::string& file,
+                     size_t line,
+                     size_t part,
+                     bool example,
+                     std::chrono::nanoseconds timeout) {
+  fmt::print("{}({}) part {:d} {:<8} cancelled after {} deadline, {} items\n", file, line, part,
+             (example ? "example:" : "input:"), formatDuration(nanos(timeout)),
+             formatCount(static_cast<double>(
+                 progress_detail::state.items.load(std::memory_order_relaxed))));
+}
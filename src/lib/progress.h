@@ -0,0 +1,106 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+namespace progress_detail {
+
+struct State final {
+  std::atomic<size_t> items;
+  std::atomic<size_t> total;
+  std::atomic<bool> cancelled;
+  uint8_t _reserved[7]{};
+};
+
+inline State state{};
+
+}  // namespace progress_detail
+
+// Progress of the part run() is running. Solvers with long loops bump the counter, which costs one
+// relaxed atomic add, and poll for cancellation, e.g.
+//
+//   progressTotal(candidates.size());
+//   for (const auto& candidate : candidates) {
+//     throwIfCancelled();
+//     ...
+//     progress();
+//   }
+//
+// A monitor thread samples the counter and, once a part has run for a while, prints items/s and,
+// if the total is known, an ETA to stderr. When the part's deadline passes (see run()) the monitor
+// flags it as cancelled; run() then reports the part as cancelled instead of checking its result.
+// A solver that does not stop within kCancelGrace of that ends the process.
+inline void progress(size_t items = 1) {
+  progress_detail::state.items.fetch_add(items, std::memory_order_relaxed);
+}
+
+// Expected number of items, or 0 if unknown.
+inline void progressTotal(size_t total) {
+  progress_detail::state.total.store(total, std::memory_order_relaxed);
+}
+
+inline bool cancelled() {
+  return progress_detail::state.cancelled.load(std::memory_order_relaxed);
+}
+
+// Thrown by throwIfCancelled(); run() catches it.
+class Cancelled final : public std::runtime_error {
+ public:
+  Cancelled() : std::runtime_error("Part cancelled") {}
+};
+
+inline void throwIfCancelled() {
+  if (cancelled()) {
+    throw Cancelled{};
+  }
+}
+
+constexpr std::chrono::seconds kCancelGrace{5};
+
+// Default deadline of parts that run() is not given one for, from --timeout=<seconds> on the
+// command line or AOC_TIMEOUT=<seconds>; zero (none) if neither is set.
+std::chrono::nanoseconds defaultTimeout();
+
+// Resets the progress state, then samples it every interval until stop() or destruction.
+class ProgressMonitor final {
+ public:
+  ProgressMonitor(std::string label,
+                  std::chrono::nanoseconds timeout,
+                  std::chrono::milliseconds interval = std::chrono::seconds{1});
+  ~ProgressMonitor();
+
+  ProgressMonitor(const ProgressMonitor&) = delete;
+  ProgressMonitor& operator=(const ProgressMonitor&) = delete;
+
+  void stop();
+
+ private:
+  void watch();
+  void report(std::chrono::steady_clock::time_point now);
+
+  std::string label_;
+  std::chrono::nanoseconds timeout_;
+  std::chrono::milliseconds interval_;
+  std::chrono::steady_clock::time_point start_;
+  std::chrono::steady_clock::time_point lastTime_;
+  size_t lastItems_;
+  std::mutex mutex_;
+  std::condition_variable stopped_;
+  bool stopping_;
+  uint8_t _reserved[7]{};
+  std::thread thread_;
+};
+
+// Prints that a part was cancelled, with its deadline and progress.
+void reportCancelled(const std::string& file,
+                     size_t line,
+                     size_t part,
+                     bool example,
+                     std::chrono::nanoseconds timeout);
@@ -0,0 +1,170 @@
+#include "lib/rss.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <stdexcept>
+#include <utility>
+
+#include <fmt/format.h>
+#include <unistd.h>
+
+#include "lib/alloc.h"
+#include "lib/io.h"
+#include "lib/to.h"
+
+namespace {
+
+RssOptions parseOptions() {
+  RssOptions options{.budget = 0, .report = hasFlag("--rss", "AOC_RSS")};
+
+  if (const auto* env = std::getenv("AOC_RSS_BUDGET")) {
+    options.budget = parseSize(env);
+  }
+  for (const auto& arg : commandLine()) {
+    const std::string_view view{arg};
+    if (view.starts_with("--rss-budget=")) {
+      options.budget = parseSize(view.substr(13));
+    }
+  }
+
+  options.report = options.report || (options.budget > 0);
+  return options;
+}
+
+// Value of a "Name:   1234 kB" line of /proc/self/status, in bytes, or 0 if missing.
+size_t statusBytes(std::string_view name) {
+  std::ifstream status{"/proc/self/status"};
+  std::string line{};
+  while (std::getline(status, line)) {
+    if (line.starts_with(name) && line.size() > name.size() && line[name.size()] == ':') {
+      const auto value = std::string_view{line}.substr(name.size() + 1);
+      const auto begin = value.find_first_not_of(" \t");
+      const auto end = value.find(' ', begin);
+      return to<size_t>(value.substr(begin, end - begin)) * 1024;
+    }
+  }
+  return 0;
+}
+
+// Writing 5 to clear_refs resets VmHWM to the current resident set (Linux 4.0+).
+bool resetPeakRss() {
+  std::ofstream clearRefs{"/proc/self/clear_refs"};
+  clearRefs << "5";
+  clearRefs.flush();
+  return clearRefs.good();
+}
+
+}  // namespace
+
+const RssOptions& rssOptions() {
+  static const auto options = parseOptions();
+  return options;
+}
+
+size_t parseSize(std::string_view str) {
+  size_t shift = 0;
+  if (!str.empty()) {
+    switch (std::toupper(static_cast<unsigned char>(str.back()))) {
+      case 'K':
+        shift = 10;
+        break;
+      case 'M':
+        shift = 20;
+        break;
+      case 'G':
+        shift = 30;
+        break;
+      case 'T':
+        shift = 40;
+        break;
+      default:
+        break;
+    }
+  }
+
+  const auto digits = (shift > 0) ? str.substr(0, str.size() - 1) : str;
+  if (digits.empty() || !std::all_of(digits.begin(), digits.end(),
+                                     [](char c) { return std::isdigit(c) != 0; })) {
+    throw std::invalid_argument(fmt::format("Invalid size '{}', expected e.g. 512M or 8G", str));
+  }
+
+  return to<size_t>(digits) << shift;
+}
+
+size_t currentRss() {
+  // Cheaper to read than /proc/self/status: "size resident shared ..." in pages.
+  std::ifstream statm{"/proc/self/statm"};
+  size_t size = 0;
+  size_t resident = 0;
+  statm >> size >> resident;
+  return resident * static_cast<size_t>(sysconf(_SC_PAGESIZE));
+}
+
+size_t peakRss() {
+  return statusBytes("VmHWM");
+}
+
+RssWatchdog::RssWatchdog(std::string label, size_t budget, std::chrono::milliseconds interval)
+    : label_(std::move(label)),
+      budget_(budget),
+      interval_(interval),
+      peak_(0),
+      mutex_(),
+      stopped_(),
+      stopping_(false),
+      peakReset_(resetPeakRss()),
+      thread_() {
+  check(currentRss());
+  thread_ = std::thread{&RssWatchdog::watch, this};
+}
+
+RssWatchdog::~RssWatchdog() {
+  stop();
+}
+
+size_t RssWatchdog::stop() {
+  if (thread_.joinable()) {
+    {
+      const std::lock_guard lock{mutex_};
+      stopping_ = true;
+    }
+    stopped_.notify_one();
+    thread_.join();
+
+    // The kernel's high water mark also catches spikes shorter than the sampling interval.
+    check(peakReset_ ? std::max(currentRss(), peakRss()) : currentRss());
+  }
+
+  return peak_.load(std::memory_order_relaxed);
+}
+
+void RssWatchdog::watch() {
+  std::unique_lock lock{mutex_};
+  while (!stopped_.wait_for(lock, interval_, [this] { return stopping_; })) {
+    check(currentRss());
+  }
+}
+
+void RssWatchdog::check(size_t rss) {
+  auto peak = peak_.load(std::memory_order_relaxed);
+  while (rss > peak && !peak_.compare_exchange_weak(peak, rss, std::memory_order_relaxed)) {
+  }
+
+  if (budget_ > 0 && rss > budget_) {
+    std::fflush(stdout);
+    fmt::print(stderr, "{}: resident set {} exceeds the budget of {}, aborting\n", label_,
+               formatBytes(static_cast<double>(rss)), formatBytes(static_cast<double>(budget_)));
+    std::abort();
+  }
+}
+
+void reportRss(const std::string& file, size_t line, size_t part, bool example, size_t peak) {
+  const auto budget = rssOptions().budget;
+  fmt::print("{}({}) part {:d} {:<8} peak rss {}{}\n", file, line, part,
+             (example ? "example:" : "input:"), formatBytes(static_cast<double>(peak)),
+             (budget > 0) ? fmt::format(" of {} budget", formatBytes(static_cast<double>(budget)))
+                          : "");
+}
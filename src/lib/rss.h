@@ -0,0 +1,65 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+
+// Memory options of run(). --rss-budget=<size> on the command line or AOC_RSS_BUDGET=<size> caps
+// the resident set of every part: a watchdog thread samples it while the part runs and aborts the
+// process with a diagnostic as soon as it goes over, rather than letting the machine swap. size is
+// in bytes with an optional binary K, M, G or T suffix, e.g. 8G. The peak resident set of every
+// part is printed after its result when a budget is set, or with --rss / AOC_RSS=1.
+struct RssOptions final {
+  size_t budget;  // 0 when there is no budget
+  bool report;
+  uint8_t _reserved[7]{};
+};
+
+const RssOptions& rssOptions();
+
+// Bytes with an optional binary suffix, e.g. "512M"; throws std::invalid_argument otherwise.
+size_t parseSize(std::string_view str);
+
+// Resident set of the process now, and its peak so far (since the last RssWatchdog if the kernel
+// supports resetting it), in bytes.
+size_t currentRss();
+size_t peakRss();
+
+// Samples currentRss() every interval on its own thread until stop() or destruction. If budget is
+// non-zero and a sample exceeds it, prints label and both sizes to stderr and aborts.
+class RssWatchdog final {
+ public:
+  explicit RssWatchdog(std::string label,
+                       size_t budget,
+                       std::chrono::milliseconds interval = std::chrono::milliseconds{10});
+  ~RssWatchdog();
+
+  RssWatchdog(const RssWatchdog&) = delete;
+  RssWatchdog& operator=(const RssWatchdog&) = delete;
+
+  // Stops sampling and returns the peak resident set seen since construction.
+  size_t stop();
+
+ private:
+  void watch();
+  void check(size_t rss);
+
+  std::string label_;
+  size_t budget_;
+  std::chrono::milliseconds interval_;
+  std::atomic<size_t> peak_;
+  std::mutex mutex_;
+  std::condition_variable stopped_;
+  bool stopping_;
+  bool peakReset_;
+  uint8_t _reserved[6]{};
+  std::thread thread_;
+};
+
+void reportRss(const std::string& file, size_t line, size_t part, bool example, size_t peak);
@@ -1,9 +1,68 @@
+#pragma once
+
+#include <chrono>
+#include <concepts>
 #include <cstddef>
+#include <optional>
 #include <source_location>
+#include <stdexcept>
 #include <string>
+#include <type_traits>
+#include <vector>
 
 #include <fmt/core.h>
 
+#include "lib/alloc.h"
+#include "lib/arena.h"
+#include "lib/bench.h"
+#include "lib/memo.h"
+#include "lib/perf.h"
+#include "lib/phase.h"
+#include "lib/progress.h"
+#include "lib/rss.h"
+#include "lib/runner.h"
+
+// Repeats fn on path as configured by benchOptions() and reports the timings.
+template <class Function>
+void benchmark_(const std::source_location& location,
+                size_t part,
+                const Function& fn,
+                bool example,
+                const std::string& path) {
+  const auto& options = benchOptions();
+
+  std::vector<double> wall{};
+  std::vector<double> cpu{};
+  for (size_t i = 0; i < options.warmups + options.repetitions; ++i) {
+    const auto wallStart = wallNanos();
+    const auto cpuStart = cpuNanos();
+    [[maybe_unused]] const auto result = fn(path);
+    const auto cpuEnd = cpuNanos();
+    const auto wallEnd = wallNanos();
+    runArena().release();
+
+    if (i >= options.warmups) {
+      wall.emplace_back(wallEnd - wallStart);
+      cpu.emplace_back(cpuEnd - cpuStart);
+    }
+  }
+
+  reportBench(location.file_name(), location.line(), part, example, wall, cpu);
+}
+
+template <class Result, class Expected>
+void check_(const std::string& comparison, const Result& result, const Expected& expected) {
+  if (result != expected) {
+    const auto error = fmt::format("Failed comparison: 'run({})'\n  result ({}) != expected ({})",
+                                   comparison, result, expected);
+    throw std::runtime_error(error);
+  }
+}
+
+// Runs part of a day on the example or the input and checks the result. With a timeout (e.g.
+// run(2, part2, false, 1234UL, std::chrono::minutes{1})), or --timeout=<seconds>, the part is
+// cancelled once it has run that long; see progress.h. Under aoc-runner parts are only timed and
+// checked (see runner.h).
 template <class Function, class Result>
 void run_(const std::source_location& location,
           const std::string& comparison,
@@ -11,17 +70,156 @@ void run_(const std::source_location& location,
           const Function& fn,
           bool example,
           const Result& expected,
+          std::chrono::nanoseconds timeout,
           const std::string& pathExample = "data/example.txt",
           const std::string& pathInput = "data/input.txt") {
-  const auto result = fn(example ? pathExample : pathInput);
+  if (auto* timings = currentDayTimings()) {
+    const auto start = wallNanos();
+    const auto result = fn(example ? pathExample : pathInput);
+    const auto nanos = wallNanos() - start;
+    timings->emplace_back(PartTiming{.part = part, .example = example, .nanos = nanos});
+    runArena().release();
+    check_(comparison, result, expected);
+    return;
+  }
 
-  fmt::print("{}({}) part {:d} {:<8} {}\n", location.file_name(), location.line(), part,
-             (example ? "example:" : "input:"), result);
+  if (phasesEnabled()) {
+    resetPhases();
+  }
 
-  if (result != expected) {
-    const auto error = fmt::format("Failed comparison: 'run({})'\n  result ({}) != expected ({})",
-                                   comparison, result, expected);
-    throw std::runtime_error(error);
+  if (timeout.count() == 0) {
+    timeout = defaultTimeout();
+  }
+
+  const auto label = fmt::format("{}({}) part {:d} {}", location.file_name(), location.line(), part,
+                                 (example ? "example" : "input"));
+
+  std::optional<RssWatchdog> watchdog{};
+  if (rssOptions().report) {
+    watchdog.emplace(label, rssOptions().budget);
+  }
+
+  ProgressMonitor monitor{label, timeout};
+
+  if (allocProfilingEnabled()) {
+    startAllocProfile();
+  }
+  if (perfEnabled()) {
+    perfCounters().start();
+  }
+  const auto memoBefore = memoReportEnabled() ? memoStats() : MemoStats{};
+
+  const auto start = wallNanos();
+  std::optional<std::decay_t<std::invoke_result_t<const Function&, const std::string&>>> result{};
+  try {
+    result.emplace(fn(example ? pathExample : pathInput));
+  } catch (const Cancelled&) {
+  }
+  const auto nanos = wallNanos() - start;
+  monitor.stop();
+  const auto wasCancelled = !result || cancelled();
+  const auto counts = perfEnabled() ? perfCounters().stop() : PerfCounts{};
+  const auto allocs = allocProfilingEnabled() ? stopAllocProfile() : AllocStats{};
+  const auto memoAfter = memoReportEnabled() ? memoStats() : MemoStats{};
+  const auto peakRss = watchdog ? watchdog->stop() : 0;
+  runArena().release();
+
+  if (wasCancelled) {
+    reportCancelled(location.file_name(), location.line(), part, example, timeout);
+  } else {
+    fmt::print("{}({}) part {:d} {:<8} {}\n", location.file_name(), location.line(), part,
+               (example ? "example:" : "input:"), *result);
+  }
+
+  if (watchdog) {
+    reportRss(location.file_name(), location.line(), part, example, peakRss);
+  }
+
+  if (allocProfilingEnabled()) {
+    reportAllocs(location.file_name(), location.line(), part, example, allocs);
+  }
+
+  if (perfEnabled()) {
+    reportPerf(location.file_name(), location.line(), part, example, counts);
+  }
+
+  if (memoReportEnabled()) {
+    reportMemo(location.file_name(), location.line(), part, example, memoBefore, memoAfter);
+  }
+
+  if (phasesEnabled()) {
+    reportPhases(location.file_name(), location.line(), part, example, nanos);
+  }
+
+  if (wasCancelled) {
+    return;
+  }
+
+  check_(comparison, *result, expected);
+
+  if (benchOptions().repetitions > 0) {
+    benchmark_(location, part, fn, example, example ? pathExample : pathInput);
+  }
+}
+
+template <class Function, class Result>
+void run_(const std::source_location& location,
+          const std::string& comparison,
+          size_t part,
+          const Function& fn,
+          bool example,
+          const Result& expected,
+          const std::string& pathExample = "data/example.txt",
+          const std::string& pathInput = "data/input.txt") {
+  run_(location, comparison, part, fn, example, expected, std::chrono::nanoseconds{0}, pathExample,
+       pathInput);
+}
+
+// Expected result of a part that run(parse, part1, part2, ...) should not run, e.g. a part without
+// an example.
+struct Skip final {};
+inline constexpr Skip kSkip{};
+
+// Parse once form of run(), for days whose parts share their parsed input:
+//
+//   run(parse, part1, part2, false, 1234UL, 5678UL);
+//   run(parse, part1, part2, true, kSkip, 10UL, "data/example2.txt");
+//
+// parse(path) runs once and its time is printed on its own line; each part then gets the parsed
+// input by const reference and is run, checked and reported like run(part, fn, ...) would, except
+// that --bench repeats only the part. path defaults to data/example.txt or data/input.txt. As
+// runArena() is released after every part, parse must not allocate its result from it.
+template <class Parse, class Part1, class Part2, class Expected1, class Expected2>
+  requires std::invocable<const Parse&, const std::string&>
+void run_(const std::source_location& location,
+          const std::string& comparison,
+          const Parse& parse,
+          const Part1& part1,
+          const Part2& part2,
+          bool example,
+          const Expected1& expected1,
+          const Expected2& expected2,
+          std::string path = {}) {
+  if (path.empty()) {
+    path = example ? "data/example.txt" : "data/input.txt";
+  }
+
+  const auto start = wallNanos();
+  const auto parsed = parse(path);
+  const auto nanos = wallNanos() - start;
+
+  if (currentDayTimings() == nullptr) {
+    fmt::print("{}({}) parse  {:<8} {}\n", location.file_name(), location.line(),
+               (example ? "example:" : "input:"), formatDuration(nanos));
+  }
+
+  if constexpr (!std::is_same_v<Expected1, Skip>) {
+    run_(location, comparison, 1, [&](const std::string&) { return part1(parsed); }, example,
+         expected1, path, path);
+  }
+  if constexpr (!std::is_same_v<Expected2, Skip>) {
+    run_(location, comparison, 2, [&](const std::string&) { return part2(parsed); }, example,
+         expected2, path, path);
   }
 }
 
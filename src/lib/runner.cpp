@@ -0,0 +1,172 @@
+#include "lib/runner.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <exception>
+#include <fstream>
+#include <limits>
+#include <map>
+#include <string_view>
+#include <thread>
+#include <utility>
+
+#include <fmt/format.h>
+
+#include "lib/bench.h"
+#include "lib/io.h"
+#include "lib/to.h"
+
+namespace {
+
+struct DayResult final {
+  std::vector<PartTiming> parts;
+  double nanos;
+  std::string error;
+};
+
+thread_local std::vector<PartTiming>* dayTimings = nullptr;
+
+std::map<std::string, double> readTimes(const std::string& path) {
+  std::map<std::string, double> times{};
+  std::ifstream file{path};
+  std::string name{};
+  double nanos = 0;
+  while (file >> name >> nanos) {
+    times[name] = nanos;
+  }
+  return times;
+}
+
+void writeTimes(const std::string& path, const std::map<std::string, double>& times) {
+  std::ofstream file{path};
+  for (const auto& [name, nanos] : times) {
+    file << fmt::format("{} {:.0f}\n", name, nanos);
+  }
+}
+
+DayResult runDay(const Day& day) {
+  DayResult result{.parts = {}, .nanos = 0, .error = {}};
+
+  setDataDir(day.dataDir);
+  dayTimings = &result.parts;
+
+  const auto start = wallNanos();
+  try {
+    day.main();
+  } catch (const std::exception& e) {
+    // One line per day in the table.
+    result.error = e.what();
+    std::replace(result.error.begin(), result.error.end(), '\n', ' ');
+  }
+  result.nanos = wallNanos() - start;
+
+  dayTimings = nullptr;
+  setDataDir({});
+  return result;
+}
+
+// Total time of the input runs of part, or "-" if it has none.
+std::string partTime(const DayResult& result, size_t part) {
+  double nanos = 0;
+  bool found = false;
+  for (const auto& timing : result.parts) {
+    if (timing.part == part && !timing.example) {
+      nanos += timing.nanos;
+      found = true;
+    }
+  }
+  return found ? formatDuration(nanos) : "-";
+}
+
+}  // namespace
+
+std::vector<Day>& registeredDays() {
+  static std::vector<Day> days{};
+  return days;
+}
+
+bool registerDay(std::string name, std::string dataDir, DayMain main) {
+  registeredDays().emplace_back(Day{.name = std::move(name), .dataDir = std::move(dataDir),
+                                    .main = main});
+  return true;
+}
+
+std::vector<PartTiming>* currentDayTimings() {
+  return dayTimings;
+}
+
+int runDays() {
+  size_t threads = std::max(1U, std::thread::hardware_concurrency());
+  std::string timesPath{};
+  for (const auto& arg : commandLine()) {
+    const std::string_view view{arg};
+    if (view.starts_with("--threads=")) {
+      threads = std::max(1UL, to<size_t>(view.substr(10)));
+    } else if (view.starts_with("--times=")) {
+      timesPath = view.substr(8);
+    }
+  }
+
+  auto& days = registeredDays();
+  std::sort(days.begin(), days.end(),
+            [](const Day& lhs, const Day& rhs) { return lhs.name < rhs.name; });
+
+  // Longest first, so the slowest day does not start last. Days without a previous time go first.
+  auto times = timesPath.empty() ? std::map<std::string, double>{} : readTimes(timesPath);
+  std::vector<size_t> order(days.size());
+  for (size_t i = 0; i < order.size(); ++i) {
+    order[i] = i;
+  }
+  const auto expected = [&](size_t i) {
+    const auto it = times.find(days[i].name);
+    return (it == times.end()) ? std::numeric_limits<double>::infinity() : it->second;
+  };
+  std::stable_sort(order.begin(), order.end(),
+                   [&](size_t lhs, size_t rhs) { return expected(lhs) > expected(rhs); });
+
+  std::vector<DayResult> results(days.size());
+  std::atomic<size_t> next{0};
+  const auto work = [&]() {
+    for (auto i = next.fetch_add(1); i < order.size(); i = next.fetch_add(1)) {
+      results[order[i]] = runDay(days[order[i]]);
+    }
+  };
+
+  const auto start = wallNanos();
+  std::vector<std::thread> workers{};
+  for (size_t i = 1; i < std::min(threads, days.size()); ++i) {
+    workers.emplace_back(work);
+  }
+  work();
+  for (auto& worker : workers) {
+    worker.join();
+  }
+  const auto wall = wallNanos() - start;
+
+  std::fflush(stdout);
+  fmt::print("{:<10} {:>10} {:>10} {:>10}  {}\n", "day", "part 1", "part 2", "total", "status");
+
+  double sum = 0;
+  size_t failed = 0;
+  for (size_t i = 0; i < days.size(); ++i) {
+    const auto& result = results[i];
+    fmt::print("{:<10} {:>10} {:>10} {:>10}  {}\n", days[i].name, partTime(result, 1),
+               partTime(result, 2), formatDuration(result.nanos),
+               result.error.empty() ? "ok" : result.error);
+
+    sum += result.nanos;
+    failed += result.error.empty() ? 0 : 1;
+    times[days[i].name] = result.nanos;
+  }
+
+  fmt::print("{} days in {} on {} threads, {} sequentially ({:.1f}x), {} failed\n", days.size(),
+             formatDuration(wall), std::min(threads, days.size()), formatDuration(sum), sum / wall,
+             failed);
+
+  if (!timesPath.empty()) {
+    writeTimes(timesPath, times);
+  }
+
+  return (failed > 0) ? 1 : 0;
+}
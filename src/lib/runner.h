@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// aoc-runner links every day of a year into one binary (see tools/makefiles/runner/makefile) and
+// runs the days concurrently on a pool of threads, longest first by the times of its previous run,
+// then prints one table of their timings. Each day's main(), renamed to dayMain(), is registered
+// with AOC_REGISTER_DAY.
+//
+// While a day runs on a runner thread, run() only times and checks its parts: the per part reports
+// (--phases, --perf, --alloc, --rss, --bench) and deadlines measure the whole process, so they are
+// left to the single day binaries.
+//
+// A day's main.cpp is pasted into namespace day_<year>_<day>, after its #include and #if lines
+// have been hoisted above it, so a day linked into the runner must:
+//   - read its input through lib/io (read(), readMapped(), forEachLine(), ...), which resolves
+//     data/... against the day's directory; a raw std::ifstream reads relative to the runner's;
+//   - not open namespace std or any other namespace meant to be global, e.g. to specialize
+//     std::hash or fmt::formatter, as it would become day_<year>_<day>::std and hide ::std;
+//   - #include only at the top of the file, as the hoisted copies come before any of its code;
+//   - define main() as "int main() {" on a line of its own.
+
+using DayMain = void (*)();
+
+struct Day final {
+  std::string name;
+  std::string dataDir;
+  DayMain main;
+};
+
+struct PartTiming final {
+  size_t part;
+  bool example;
+  uint8_t _reserved[7]{};
+  double nanos;
+};
+
+std::vector<Day>& registeredDays();
+
+// Always true, for use as a static initializer.
+bool registerDay(std::string name, std::string dataDir, DayMain main);
+
+#define AOC_REGISTER_DAY(name, dataDir, main)                                      \
+  namespace {                                                                      \
+  [[maybe_unused]] const bool aocDayRegistered = registerDay(name, dataDir, main); \
+  }
+
+// Timings of the parts run() has run so far on this thread's day, or nullptr outside aoc-runner.
+std::vector<PartTiming>* currentDayTimings();
+
+// The runner's main(). Options: --threads=N (default every core) and --times=<path>, where the
+// day times are read from to order the days and written back to afterwards. Returns non-zero if
+// any day failed.
+int runDays();
@@ -0,0 +1,150 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "lib/chars.h"
+#include "lib/delim.h"
+
+// Outcome of a scan. On a mismatch, fields is the number of fields that were stored before it and
+// position is where in the input matching stopped.
+struct ScanResult final {
+  size_t fields;
+  size_t position;
+  bool ok;
+  uint8_t _reserved[7]{};
+
+  constexpr explicit operator bool() const { return ok; }
+};
+
+namespace scan_detail {
+
+// "{}" placeholders split the format into literal pieces, one more than there are fields.
+template <FixedString format>
+constexpr size_t numFields() {
+  size_t count = 0;
+  for (size_t pos = format.view().find("{}"); pos != std::string_view::npos;
+       pos = format.view().find("{}", pos + 2)) {
+    ++count;
+  }
+
+  return count;
+}
+
+template <FixedString format>
+constexpr auto literals() {
+  std::array<std::string_view, numFields<format>() + 1> pieces{};
+  const auto view = format.view();
+
+  size_t begin = 0;
+  for (auto& piece : pieces) {
+    const auto end = std::min(view.find("{}", begin), view.size());
+    piece = view.substr(begin, end - begin);
+    begin = end + 2;
+  }
+
+  return pieces;
+}
+
+// Parses one field from the start of str. Text fields run up to the first character of the literal
+// that follows them (or to the end of the input). Returns the number of characters consumed, or
+// npos on a mismatch.
+template <class Field>
+size_t parseField(std::string_view str, std::string_view next, Field& field) {
+  if constexpr (std::is_same_v<Field, char>) {
+    if (str.empty()) {
+      return std::string_view::npos;
+    }
+    field = str.front();
+    return 1;
+  } else if constexpr (std::is_arithmetic_v<Field>) {
+    Field parsed{};
+    const auto consumed = fromCharsPrefix(str, parsed);
+    if (consumed == 0) {
+      return std::string_view::npos;
+    }
+    // fromCharsPrefix wraps "-3" around for unsigned types; a field that cannot hold it mismatches.
+    if (std::is_unsigned_v<Field> && str.substr(0, consumed).find('-') != std::string_view::npos) {
+      return std::string_view::npos;
+    }
+    field = parsed;
+    return consumed;
+  } else {
+    static_assert(std::is_same_v<Field, std::string_view> || std::is_same_v<Field, std::string>,
+                  "scan fields must be arithmetic, char, std::string_view or std::string");
+    const auto end = next.empty() ? str.size() : std::min(str.find(next.front()), str.size());
+    field = Field{str.substr(0, end)};
+    return end;
+  }
+}
+
+}  // namespace scan_detail
+
+// Matches str against a format whose "{}" placeholders are parsed at compile time, storing each
+// field straight into the given references, e.g.
+//
+//   scanInto<"p={},{} v={},{}">(line, robot.position.x, robot.position.y, ...);
+//
+// Literal text must match exactly and the whole input must be consumed. Never throws, see
+// ScanResult; fields past a mismatch are left untouched.
+template <FixedString format, class... Fields>
+ScanResult scanInto(std::string_view str, Fields&... fields) {
+  constexpr auto kLiterals = scan_detail::literals<format>();
+  static_assert(sizeof...(Fields) + 1 == kLiterals.size(),
+                "number of fields does not match the number of {} placeholders in the format");
+
+  ScanResult result{.fields = 0, .position = 0, .ok = false};
+
+  const auto literal = [&str, &result](std::string_view expected) {
+    if (!str.substr(result.position).starts_with(expected)) {
+      return false;
+    }
+    result.position += expected.size();
+    return true;
+  };
+
+  if (!literal(kLiterals[0])) {
+    return result;
+  }
+
+  const auto matched = [&]<size_t... I>(std::index_sequence<I...>) {
+    [[maybe_unused]] const auto field = [&]<size_t J>(std::integral_constant<size_t, J>,
+                                                      auto& out) {
+      const auto consumed =
+          scan_detail::parseField(str.substr(result.position), kLiterals[J + 1], out);
+      if (consumed == std::string_view::npos) {
+        return false;
+      }
+      result.position += consumed;
+      ++result.fields;
+      return literal(kLiterals[J + 1]);
+    };
+
+    return (field(std::integral_constant<size_t, I>{}, fields) && ...);
+  }(std::index_sequence_for<Fields...>{});
+
+  result.ok = matched && (result.position == str.size());
+  return result;
+}
+
+// As scanInto(), returning the fields as a tuple, or nullopt on a mismatch.
+template <FixedString format, class... Fields>
+std::optional<std::tuple<Fields...>> scan(std::string_view str) {
+  std::tuple<Fields...> fields{};
+  const auto result = std::apply(
+      [&str](auto&... field) { return scanInto<format>(str, field...); }, fields);
+
+  if (!result) {
+    return std::nullopt;
+  }
+
+  return fields;
+}
@@ -0,0 +1,58 @@
+#include "lib/search.h"
+
+#include <cstddef>
+#include <numeric>
+#include <vector>
+
+SearchResult::SearchResult(size_t states, bool predecessors)
+    : distance_(states, kUnreached), edges_(), goal_(kUnreached), predecessors_(predecessors) {}
+
+std::vector<size_t> SearchResult::onShortestPaths(const std::vector<size_t>& targets) const {
+  // The recorded edges that are still tight, grouped by their end (compressed sparse rows).
+  std::vector<size_t> offsets(distance_.size() + 1, 0);
+  const auto tight = [this](const search_detail::Edge& edge) {
+    return distance_[edge.from] + edge.weight == distance_[edge.to];
+  };
+  for (const auto& edge : edges_) {
+    if (tight(edge)) {
+      ++offsets[edge.to + 1];
+    }
+  }
+  std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+
+  std::vector<size_t> froms(offsets.back());
+  auto fill = offsets;
+  for (const auto& edge : edges_) {
+    if (tight(edge)) {
+      froms[fill[edge.to]++] = edge.from;
+    }
+  }
+
+  // Edges can be recorded twice (e.g. from two sources), so states are marked once.
+  std::vector<bool> on(distance_.size(), false);
+  std::vector<size_t> stack{};
+  for (const auto target : targets) {
+    if (reached(target) && !on[target]) {
+      on[target] = true;
+      stack.push_back(target);
+    }
+  }
+  while (!stack.empty()) {
+    const auto state = stack.back();
+    stack.pop_back();
+    for (auto i = offsets[state]; i < offsets[state + 1]; ++i) {
+      if (!on[froms[i]]) {
+        on[froms[i]] = true;
+        stack.push_back(froms[i]);
+      }
+    }
+  }
+
+  std::vector<size_t> states{};
+  for (size_t state = 0; state < on.size(); ++state) {
+    if (on[state]) {
+      states.push_back(state);
+    }
+  }
+  return states;
+}
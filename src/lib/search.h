@@ -0,0 +1,281 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <utility>
+#include <vector>
+
+// Shortest path searches over states encoded densely as 0 ... states - 1 (e.g. a grid index, times
+// 4 headings, plus the heading), so distances live in one flat array rather than a map. The graph
+// is given by a neighbours function that calls visit for every edge out of a state:
+//
+//   // Unit weights (bfs): visit(next). Weighted (bfs01, dial, aStar): visit(next, weight).
+//   const auto neighbours = [&](size_t state, const auto& visit) { ... };
+//   const auto result = dial(states, {start}, neighbours, 1001, [&](size_t s) { return ...; });
+//
+// A search stops at the first goal state it settles, or runs until every reachable state is
+// settled if the goal never holds. With predecessors set it also records every edge that ends a
+// shortest path, for onShortestPaths(), and settles all states as far as the goal before stopping.
+
+inline constexpr size_t kUnreached = std::numeric_limits<size_t>::max();
+
+namespace search_detail {
+
+struct Edge final {
+  size_t to;
+  size_t from;
+  size_t weight;
+};
+
+struct NoGoal final {
+  bool operator()(size_t) const { return false; }
+};
+
+}  // namespace search_detail
+
+class SearchResult final {
+ public:
+  SearchResult(size_t states, bool predecessors);
+
+  // Distance from the nearest source, or kUnreached.
+  size_t distance(size_t state) const { return distance_[state]; }
+  bool reached(size_t state) const { return distance_[state] != kUnreached; }
+  const std::vector<size_t>& distances() const { return distance_; }
+
+  // The goal state the search stopped at, or kUnreached if it ran to completion.
+  size_t goal() const { return goal_; }
+
+  // Every state on some shortest path from a source to one of targets, in increasing order.
+  // Requires a search run with predecessors; targets should be reached at the same, minimal
+  // distance, e.g. all headings of an end cell that tie for the shortest path.
+  std::vector<size_t> onShortestPaths(const std::vector<size_t>& targets) const;
+
+  // For the searches below.
+  void setSource(size_t state) { distance_[state] = 0; }
+  void setGoal(size_t state) { goal_ = state; }
+  bool tracksPredecessors() const { return predecessors_; }
+
+  // Lowers the distance of to via the edge from -> to and returns true if that improved it.
+  bool relax(size_t from, size_t to, size_t weight) {
+    const auto candidate = distance_[from] + weight;
+    if (candidate > distance_[to]) {
+      return false;
+    }
+    if (predecessors_) {
+      edges_.push_back({.to = to, .from = from, .weight = weight});
+    }
+    if (candidate == distance_[to]) {
+      return false;
+    }
+    distance_[to] = candidate;
+    return true;
+  }
+
+ private:
+  std::vector<size_t> distance_;
+  // Edges that were as short as the best path to their end when they were relaxed; the ones
+  // that still are make up the shortest path graph.
+  std::vector<search_detail::Edge> edges_;
+  size_t goal_;
+  bool predecessors_;
+  uint8_t _reserved[7]{};
+};
+
+namespace search_detail {
+
+// Decides, for a state just settled at distance (its estimate in A*), whether the search is over.
+template <class Goal>
+class Stop final {
+ public:
+  Stop(const Goal& goal, SearchResult& result) : goal_(goal), result_(result) {}
+
+  bool operator()(size_t state, size_t distance) {
+    if (result_.goal() != kUnreached) {
+      return distance > result_.distance(result_.goal());
+    }
+    if (goal_(state)) {
+      result_.setGoal(state);
+      return !result_.tracksPredecessors();
+    }
+    return false;
+  }
+
+ private:
+  const Goal& goal_;
+  SearchResult& result_;
+};
+
+}  // namespace search_detail
+
+// Breadth first search, for graphs whose edges all have weight 1.
+template <class Neighbours, class Goal = search_detail::NoGoal>
+SearchResult bfs(size_t states,
+                 const std::vector<size_t>& sources,
+                 const Neighbours& neighbours,
+                 const Goal& goal = {},
+                 bool predecessors = false) {
+  SearchResult result{states, predecessors};
+  search_detail::Stop stop{goal, result};
+
+  // States are queued once each, so the queue is one flat array.
+  std::vector<size_t> queue{};
+  queue.reserve(states);
+  for (const auto source : sources) {
+    result.setSource(source);
+    queue.push_back(source);
+  }
+
+  for (size_t head = 0; head < queue.size(); ++head) {
+    const auto state = queue[head];
+    if (stop(state, result.distance(state))) {
+      break;
+    }
+    neighbours(state, [&](size_t next) {
+      if (result.relax(state, next, 1)) {
+        queue.push_back(next);
+      }
+    });
+  }
+
+  return result;
+}
+
+// Breadth first search over a deque, for graphs whose edges have weight 0 or 1.
+template <class Neighbours, class Goal = search_detail::NoGoal>
+SearchResult bfs01(size_t states,
+                   const std::vector<size_t>& sources,
+                   const Neighbours& neighbours,
+                   const Goal& goal = {},
+                   bool predecessors = false) {
+  SearchResult result{states, predecessors};
+  search_detail::Stop stop{goal, result};
+
+  std::deque<std::pair<size_t, size_t>> queue{};
+  for (const auto source : sources) {
+    result.setSource(source);
+    queue.emplace_back(source, 0);
+  }
+
+  while (!queue.empty()) {
+    const auto [state, distance] = queue.front();
+    queue.pop_front();
+    if (distance != result.distance(state)) {
+      continue;  // superseded by a shorter path
+    }
+    if (stop(state, distance)) {
+      break;
+    }
+    neighbours(state, [&](size_t next, size_t weight) {
+      assert(weight <= 1);
+      if (result.relax(state, next, weight)) {
+        if (weight == 0) {
+          queue.emplace_front(next, distance);
+        } else {
+          queue.emplace_back(next, distance + 1);
+        }
+      }
+    });
+  }
+
+  return result;
+}
+
+// Dijkstra's algorithm with Dial's bucket queue, for edge weights in [0, maxWeight]: one bucket
+// per distance modulo maxWeight + 1, so pushing and popping are O(1) instead of O(log n), e.g.
+// for the 1 or 1001 of moving or turning and moving, or the 1 ... 9 of digit cost grids.
+template <class Neighbours, class Goal = search_detail::NoGoal>
+SearchResult dial(size_t states,
+                  const std::vector<size_t>& sources,
+                  const Neighbours& neighbours,
+                  size_t maxWeight,
+                  const Goal& goal = {},
+                  bool predecessors = false) {
+  SearchResult result{states, predecessors};
+  search_detail::Stop stop{goal, result};
+
+  std::vector<std::vector<size_t>> buckets(maxWeight + 1);
+  size_t pending = 0;
+  for (const auto source : sources) {
+    result.setSource(source);
+    buckets.front().push_back(source);
+    ++pending;
+  }
+
+  // The bucket of distance is distance % buckets.size(), kept without dividing.
+  const auto wrap = [&buckets](size_t bucket) {
+    return (bucket >= buckets.size()) ? bucket - buckets.size() : bucket;
+  };
+
+  for (size_t distance = 0, current = 0; pending > 0; ++distance, current = wrap(current + 1)) {
+    // Weight 0 edges push to the bucket being drained, so it is re-read until empty.
+    auto& bucket = buckets[current];
+    while (!bucket.empty()) {
+      const auto state = bucket.back();
+      bucket.pop_back();
+      --pending;
+
+      if (distance != result.distance(state)) {
+        continue;  // superseded by a shorter path
+      }
+      if (stop(state, distance)) {
+        return result;
+      }
+      neighbours(state, [&](size_t next, size_t weight) {
+        assert(weight <= maxWeight);
+        if (result.relax(state, next, weight)) {
+          buckets[wrap(current + weight)].push_back(next);
+          ++pending;
+        }
+      });
+    }
+  }
+
+  return result;
+}
+
+// A* with a binary heap. heuristic(state) must never overestimate the distance left to a goal
+// and must be consistent (drop by at most the weight of any edge), so states settle once.
+template <class Neighbours, class Heuristic, class Goal>
+SearchResult aStar(size_t states,
+                   const std::vector<size_t>& sources,
+                   const Neighbours& neighbours,
+                   const Heuristic& heuristic,
+                   const Goal& goal,
+                   bool predecessors = false) {
+  SearchResult result{states, predecessors};
+  search_detail::Stop stop{goal, result};
+
+  // (estimate, state), smallest estimate first.
+  using Entry = std::pair<size_t, size_t>;
+  std::priority_queue<Entry, std::vector<Entry>, std::greater<>> queue{};
+  for (const auto source : sources) {
+    result.setSource(source);
+    queue.emplace(heuristic(source), source);
+  }
+
+  while (!queue.empty()) {
+    const auto [estimate, state] = queue.top();
+    queue.pop();
+
+    const auto distance = result.distance(state);
+    if (estimate != distance + heuristic(state)) {
+      continue;  // superseded by a shorter path
+    }
+    // States settle in estimate order, and a goal's estimate is its distance.
+    if (stop(state, estimate)) {
+      break;
+    }
+    neighbours(state, [&](size_t next, size_t weight) {
+      if (result.relax(state, next, weight)) {
+        queue.emplace(result.distance(next) + heuristic(next), next);
+      }
+    });
+  }
+
+  return result;
+}
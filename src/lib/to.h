@@ -5,13 +5,19 @@
 #include <concepts>
 #include <cstddef>
 #include <cstdint>
+#include <memory_resource>
+#include <stdexcept>
 #include <string>
+#include <string_view>
 #include <tuple>
 #include <vector>
 
 #include <fmt/core.h>
 #include <fmt/ranges.h>
 
+#include "lib/chars.h"
+#include "lib/phase.h"
+
 ///// interface /////
 
 template <class ToType, class FromType>
@@ -34,6 +40,11 @@ concept ContainerArithmetic = Container<T> && std::is_arithmetic_v<typename T::v
 template <typename T>
 concept ContainerString = Container<T> && std::same_as<typename T::value_type, std::string>;
 
+template <typename T>
+concept PmrContainer =
+    Container<T> && std::same_as<typename T::allocator_type,
+                                 std::pmr::polymorphic_allocator<typename T::value_type>>;
+
 template <typename T>
 concept Enum = std::is_enum_v<std::remove_cv_t<T>>;
 
@@ -64,6 +75,22 @@ ToType to(FromType&& from) {
   return std::move(from);
 }
 
+template <class ToType, class FromType>
+  requires(std::same_as<std::remove_cv_t<ToType>, std::string> ||
+           std::same_as<std::remove_cv_t<ToType>, std::string_view>) &&
+          std::same_as<std::remove_cv_t<FromType>, std::string_view>
+ToType to(const FromType& from) {
+  return ToType{from};
+}
+
+template <class ToType, class FromType>
+  requires(std::same_as<std::remove_cv_t<ToType>, std::string> ||
+           std::same_as<std::remove_cv_t<ToType>, std::string_view>) &&
+          std::same_as<std::remove_cvref_t<FromType>, std::string_view>
+ToType to(FromType&& from) {
+  return ToType{from};
+}
+
 template <class ToType, class FromType>
   requires EnumArithmetic<FromType> && Arithmetic<ToType>
 constexpr ToType to(const FromType& from) {
@@ -103,36 +130,43 @@ ToType to(FromType&& from) {
 }
 
 template <class ToType, class FromType>
-  requires std::is_arithmetic_v<ToType> && std::same_as<std::remove_cv_t<FromType>, std::string>
+  requires std::is_arithmetic_v<ToType> &&
+           std::same_as<std::remove_cv_t<FromType>, std::string_view>
 ToType to(const FromType& from) {
-  if constexpr (std::is_integral_v<ToType>) {
-    if constexpr (std::is_unsigned_v<ToType>) {
-      return static_cast<ToType>(std::stoull(from));
-    } else {
-      return static_cast<ToType>(std::stoll(from));
-    }
-  } else if constexpr (std::is_floating_point_v<ToType>) {
-    return static_cast<ToType>(std::stold(from));
+  if (const auto value = fromChars<ToType>(from)) {
+    return *value;
   }
+
+  throw std::invalid_argument(fmt::format("Can not convert '{}' to arithmetic type", from));
 }
 
 template <class ToType, class FromType>
-  requires std::is_arithmetic_v<ToType> && std::same_as<std::remove_cv_t<FromType>, std::string>
+  requires std::is_arithmetic_v<ToType> &&
+           std::same_as<std::remove_cvref_t<FromType>, std::string_view>
 ToType to(FromType&& from) {
-  if constexpr (std::is_integral_v<ToType>) {
-    if constexpr (std::is_unsigned_v<ToType>) {
-      return static_cast<ToType>(std::stoull(from));
-    } else {
-      return static_cast<ToType>(std::stoll(from));
-    }
-  } else if constexpr (std::is_floating_point_v<ToType>) {
-    return static_cast<ToType>(std::stold(from));
+  if (const auto value = fromChars<ToType>(from)) {
+    return *value;
   }
+
+  throw std::invalid_argument(fmt::format("Can not convert '{}' to arithmetic type", from));
+}
+
+template <class ToType, class FromType>
+  requires std::is_arithmetic_v<ToType> && std::same_as<std::remove_cv_t<FromType>, std::string>
+ToType to(const FromType& from) {
+  return to<ToType>(std::string_view{from});
+}
+
+template <class ToType, class FromType>
+  requires std::is_arithmetic_v<ToType> && std::same_as<std::remove_cv_t<FromType>, std::string>
+ToType to(FromType&& from) {
+  return to<ToType>(std::string_view{from});
 }
 
 template <class ToType, class FromType>
   requires ContainerArithmetic<ToType> && ContainerString<FromType>
 ToType to(const FromType& from) {
+  AOC_PHASE("to");
   ToType vec{};
 
   std::transform(from.begin(), from.end(), std::back_inserter(vec),
@@ -144,6 +178,7 @@ ToType to(const FromType& from) {
 template <class ToType, class FromType>
   requires ContainerArithmetic<ToType> && ContainerString<FromType>
 ToType to(FromType&& from) {
+  AOC_PHASE("to");
   ToType vec{};
 
   std::transform(from.begin(), from.end(), std::back_inserter(vec),
@@ -201,3 +236,35 @@ ToType to(const FromType& from) {
 
   return to<ToType>(const_cast<std::add_lvalue_reference_t<std::add_const_t<decltype(vec)>>>(vec));
 }
+
+///// std::pmr /////
+
+namespace to_detail {
+
+template <class ToType>
+ToType element(std::string_view from, std::pmr::memory_resource* resource) {
+  if constexpr (std::same_as<ToType, std::pmr::string>) {
+    return ToType{from, resource};
+  } else {
+    return to<ToType>(from);
+  }
+}
+
+}  // namespace to_detail
+
+// Converts a range of strings (or string_views) into a std::pmr container allocated from
+// resource, e.g. to<std::pmr::vector<size_t>>(tokens, runArena().resource()). std::pmr::string
+// elements are allocated from resource as well.
+template <class ToType, class FromType>
+  requires PmrContainer<ToType> && Container<FromType>
+ToType to(const FromType& from, std::pmr::memory_resource* resource) {
+  AOC_PHASE("to");
+  ToType ret(typename ToType::allocator_type{resource});
+
+  for (const auto& s : from) {
+    ret.insert(ret.end(),
+               to_detail::element<typename ToType::value_type>(std::string_view{s}, resource));
+  }
+
+  return ret;
+}
@@ -0,0 +1,79 @@
+#include "lib/extract.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <fmt/format.h>
+#include <sys/types.h>
+
+#include "benchmark/benchmark.h"
+#include "lib/parse.h"
+#include "lib/scan.h"
+
+namespace {
+
+// 2024/14 style robot lines, "p=12,34 v=-5,67".
+const std::string& robots() {
+  static const auto lines = [] {
+    std::mt19937_64 gen{14};
+    std::uniform_int_distribution<int> position{0, 100};
+    std::uniform_int_distribution<int> velocity{-100, 100};
+
+    std::string str{};
+    for (size_t i = 0; i < 100000; ++i) {
+      str += fmt::format("p={},{} v={},{}\n", position(gen), position(gen), velocity(gen),
+                         velocity(gen));
+    }
+    return str;
+  }();
+
+  return lines;
+}
+
+void BenchmarkScanInto(benchmark::State& state) {
+  for (auto _ : state) {
+    ssize_t sum = 0;
+    for (const auto line : split<"\n">(robots())) {
+      ssize_t px = 0;
+      ssize_t py = 0;
+      ssize_t vx = 0;
+      ssize_t vy = 0;
+      scanInto<"p={},{} v={},{}">(line, px, py, vx, vy);
+      sum += px + py + vx + vy;
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * robots().size()));
+}
+
+void BenchmarkExtractInts(benchmark::State& state) {
+  std::vector<ssize_t> ints{};
+  for (auto _ : state) {
+    ints.clear();
+    extractInts<ssize_t>(robots(), std::back_inserter(ints));
+    benchmark::DoNotOptimize(ints.data());
+  }
+
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * robots().size()));
+}
+
+void BenchmarkExtractIntColumns(benchmark::State& state) {
+  for (auto _ : state) {
+    const auto columns = extractIntColumns<ssize_t>(robots(), 4);
+    benchmark::DoNotOptimize(columns.column(0).data());
+  }
+
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * robots().size()));
+}
+
+}  // namespace
+
+BENCHMARK(BenchmarkScanInto);
+BENCHMARK(BenchmarkExtractInts);
+BENCHMARK(BenchmarkExtractIntColumns);
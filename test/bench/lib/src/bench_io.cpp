@@ -0,0 +1,75 @@
+#include "lib/io.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#include "benchmark/benchmark.h"
+#include "inputs.h"
+
+namespace {
+
+void setProcessed(benchmark::State& state, const std::string& input) {
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * countLines(input)));
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * input.size()));
+}
+
+// Items are lines. Files are read from the page cache after the first iteration.
+void BenchmarkRead(benchmark::State& state) {
+  const auto bytes = static_cast<size_t>(state.range(0));
+  const auto& path = numberFile(bytes);
+
+  for (auto _ : state) {
+    const auto str = read(path);
+    benchmark::DoNotOptimize(str.data());
+  }
+
+  setProcessed(state, numberLines(bytes));
+}
+
+void BenchmarkReadMapped(benchmark::State& state) {
+  const auto bytes = static_cast<size_t>(state.range(0));
+  const auto& path = numberFile(bytes);
+
+  for (auto _ : state) {
+    const auto file = readMapped(path);
+    benchmark::DoNotOptimize(file.view().data());
+  }
+
+  setProcessed(state, numberLines(bytes));
+}
+
+// Mapping alone does not touch the pages; this also reads every byte.
+void BenchmarkReadMappedScan(benchmark::State& state) {
+  const auto bytes = static_cast<size_t>(state.range(0));
+  const auto& path = numberFile(bytes);
+
+  for (auto _ : state) {
+    const auto file = readMapped(path);
+    benchmark::DoNotOptimize(std::count(file.view().begin(), file.view().end(), '\n'));
+  }
+
+  setProcessed(state, numberLines(bytes));
+}
+
+void BenchmarkForEachLine(benchmark::State& state) {
+  const auto bytes = static_cast<size_t>(state.range(0));
+  const auto& path = numberFile(bytes);
+
+  for (auto _ : state) {
+    size_t lines = 0;
+    forEachLine(path, [&lines](std::string_view) { ++lines; });
+    benchmark::DoNotOptimize(lines);
+  }
+
+  setProcessed(state, numberLines(bytes));
+}
+
+}  // namespace
+
+BENCHMARK(BenchmarkRead)->Apply(inputSizes);
+BENCHMARK(BenchmarkReadMapped)->Apply(inputSizes);
+BENCHMARK(BenchmarkReadMappedScan)->Apply(inputSizes);
+BENCHMARK(BenchmarkForEachLine)->Apply(inputSizes);
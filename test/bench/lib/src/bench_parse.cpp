@@ -0,0 +1,187 @@
+#include "lib/parse.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "inputs.h"
+#include "lib/to.h"
+
+namespace {
+
+constexpr size_t kNumbersPerLine = 2;
+
+void setProcessed(benchmark::State& state, const std::string& input, size_t itemsPerLine) {
+  state.SetItemsProcessed(
+      static_cast<int64_t>(state.iterations() * countLines(input) * itemsPerLine));
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * input.size()));
+}
+
+// The owning split() overloads consume their input, as they would the result of read(), so every
+// iteration starts with a copy. This is the cost of that copy alone.
+void BenchmarkCopy(benchmark::State& state) {
+  const auto& input = numberLines(static_cast<size_t>(state.range(0)));
+
+  for (auto _ : state) {
+    std::string copy{input};
+    benchmark::DoNotOptimize(copy.data());
+  }
+
+  setProcessed(state, input, 1);
+}
+
+// Items are lines.
+void BenchmarkSplitChar(benchmark::State& state) {
+  const auto& input = numberLines(static_cast<size_t>(state.range(0)));
+
+  for (auto _ : state) {
+    const auto lines = split(std::string{input}, "\n");
+    benchmark::DoNotOptimize(lines.data());
+  }
+
+  setProcessed(state, input, 1);
+}
+
+// The boost::regex path, taken for multi-char delimiters. Items are numbers.
+void BenchmarkSplitRegex(benchmark::State& state) {
+  const auto& input = numberLines(static_cast<size_t>(state.range(0)));
+
+  for (auto _ : state) {
+    const auto numbers = split(std::string{input}, "\\s+", true);
+    benchmark::DoNotOptimize(numbers.data());
+  }
+
+  setProcessed(state, input, kNumbersPerLine);
+}
+
+void BenchmarkSplitView(benchmark::State& state) {
+  const auto& input = numberLines(static_cast<size_t>(state.range(0)));
+
+  for (auto _ : state) {
+    size_t lines = 0;
+    for (const auto line : splitView(input, "\n")) {
+      lines += line.size();
+    }
+    benchmark::DoNotOptimize(lines);
+  }
+
+  setProcessed(state, input, 1);
+}
+
+void BenchmarkSplitStatic(benchmark::State& state) {
+  const auto& input = numberLines(static_cast<size_t>(state.range(0)));
+
+  for (auto _ : state) {
+    size_t lines = 0;
+    for (const auto line : split<"\n">(input)) {
+      lines += line.size();
+    }
+    benchmark::DoNotOptimize(lines);
+  }
+
+  setProcessed(state, input, 1);
+}
+
+// Items are numbers.
+void BenchmarkSplitTo(benchmark::State& state) {
+  const auto& input = numberLines(static_cast<size_t>(state.range(0)));
+
+  for (auto _ : state) {
+    const auto numbers = splitTo<std::vector<size_t>>(std::string{input}, " \n");
+    benchmark::DoNotOptimize(numbers.data());
+  }
+
+  setProcessed(state, input, kNumbersPerLine);
+}
+
+void BenchmarkSplitToStatic(benchmark::State& state) {
+  const auto& input = numberLines(static_cast<size_t>(state.range(0)));
+
+  for (auto _ : state) {
+    const auto numbers = splitTo<std::vector<size_t>>(split<" \n">(input));
+    benchmark::DoNotOptimize(numbers.data());
+  }
+
+  setProcessed(state, input, kNumbersPerLine);
+}
+
+// Items are lines, each split into a pair of numbers.
+void BenchmarkSplitToPair(benchmark::State& state) {
+  const auto& input = numberLines(static_cast<size_t>(state.range(0)));
+
+  for (auto _ : state) {
+    size_t sum = 0;
+    for (const auto line : split<"\n">(input)) {
+      const auto [lhs, rhs] = splitToPair<size_t, size_t>(std::string{line}, " ");
+      sum += lhs + rhs;
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+
+  setProcessed(state, input, 1);
+}
+
+void BenchmarkSplitToPairStatic(benchmark::State& state) {
+  const auto& input = numberLines(static_cast<size_t>(state.range(0)));
+
+  for (auto _ : state) {
+    size_t sum = 0;
+    for (const auto line : split<"\n">(input)) {
+      const auto [lhs, rhs] = splitToPair<size_t, size_t>(split<" ">(line));
+      sum += lhs + rhs;
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+
+  setProcessed(state, input, 1);
+}
+
+// to<> of already split tokens: the container and pair specializations. Items are numbers.
+void BenchmarkToContainer(benchmark::State& state) {
+  const auto& input = numberLines(static_cast<size_t>(state.range(0)));
+  const auto tokens = split(std::string{input}, " \n");
+
+  for (auto _ : state) {
+    const auto numbers = to<std::vector<size_t>>(tokens);
+    benchmark::DoNotOptimize(numbers.data());
+  }
+
+  setProcessed(state, input, kNumbersPerLine);
+}
+
+void BenchmarkToPair(benchmark::State& state) {
+  const auto& input = numberLines(static_cast<size_t>(state.range(0)));
+  std::vector<std::vector<std::string>> pairs{};
+  for (const auto line : split<"\n">(input)) {
+    pairs.emplace_back(split(std::string{line}, " "));
+  }
+
+  for (auto _ : state) {
+    size_t sum = 0;
+    for (const auto& pair : pairs) {
+      const auto [lhs, rhs] = to<std::pair<size_t, size_t>>(pair);
+      sum += lhs + rhs;
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+
+  setProcessed(state, input, 1);
+}
+
+}  // namespace
+
+BENCHMARK(BenchmarkCopy)->Apply(inputSizes);
+BENCHMARK(BenchmarkSplitChar)->Apply(inputSizes);
+BENCHMARK(BenchmarkSplitRegex)->Apply(inputSizes);
+BENCHMARK(BenchmarkSplitView)->Apply(inputSizes);
+BENCHMARK(BenchmarkSplitStatic)->Apply(inputSizes);
+BENCHMARK(BenchmarkSplitTo)->Apply(inputSizes);
+BENCHMARK(BenchmarkSplitToStatic)->Apply(inputSizes);
+BENCHMARK(BenchmarkSplitToPair)->Apply(inputSizes);
+BENCHMARK(BenchmarkSplitToPairStatic)->Apply(inputSizes);
+BENCHMARK(BenchmarkToContainer)->Apply(inputSizes);
+BENCHMARK(BenchmarkToPair)->Apply(inputSizes);
@@ -0,0 +1,83 @@
+#include "lib/to.h"
+
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+namespace {
+
+// A million numbers, like the 2024/01 and 2024/02 location id and report lists.
+constexpr size_t kNumNumbers = 1000000;
+
+const std::vector<std::string>& numbers(uint64_t max) {
+  static std::map<uint64_t, std::vector<std::string>> cache{};
+  auto& nums = cache[max];
+
+  if (nums.empty()) {
+    std::mt19937_64 gen{max};
+    std::uniform_int_distribution<uint64_t> dist{0, max};
+    for (size_t i = 0; i < kNumNumbers; ++i) {
+      nums.emplace_back(std::to_string(dist(gen)));
+    }
+  }
+
+  return nums;
+}
+
+template <class Parse>
+void parseAll(benchmark::State& state, const Parse& parse) {
+  const auto& nums = numbers(static_cast<uint64_t>(state.range(0)));
+
+  size_t bytes = 0;
+  for (const auto& num : nums) {
+    bytes += num.size();
+  }
+
+  for (auto _ : state) {
+    uint64_t sum = 0;
+    for (const auto& num : nums) {
+      sum += parse(num);
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * nums.size()));
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * bytes));
+}
+
+void BenchmarkStoull(benchmark::State& state) {
+  parseAll(state, [](const std::string& num) { return std::stoull(num); });
+}
+
+void BenchmarkFromChars(benchmark::State& state) {
+  parseAll(state, [](const std::string& num) {
+    uint64_t value = 0;
+    std::from_chars(std::to_address(num.begin()), std::to_address(num.end()), value);
+    return value;
+  });
+}
+
+void BenchmarkToFromString(benchmark::State& state) {
+  parseAll(state, [](const std::string& num) { return to<uint64_t>(num); });
+}
+
+void BenchmarkToFromStringView(benchmark::State& state) {
+  parseAll(state, [](const std::string& num) { return to<uint64_t>(std::string_view{num}); });
+}
+
+}  // namespace
+
+// Arg is the largest generated value: 5 digit ids (2024/01) and up to 19 digit values, as Arg is an
+// int64_t and cannot reach UINT64_MAX.
+BENCHMARK(BenchmarkStoull)->Arg(99999)->Arg(INT64_MAX);
+BENCHMARK(BenchmarkFromChars)->Arg(99999)->Arg(INT64_MAX);
+BENCHMARK(BenchmarkToFromString)->Arg(99999)->Arg(INT64_MAX);
+BENCHMARK(BenchmarkToFromStringView)->Arg(99999)->Arg(INT64_MAX);
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <random>
+#include <string>
+#include <string_view>
+#include <system_error>
+
+#include <fmt/format.h>
+
+#include "benchmark/benchmark.h"
+
+namespace inputs_detail {
+
+inline std::map<size_t, std::string>& lines() {
+  static std::map<size_t, std::string> lines{};
+  return lines;
+}
+
+inline std::map<size_t, std::string>& files() {
+  static std::map<size_t, std::string> files{};
+  return files;
+}
+
+// Runs after each benchmark at each size. Google Benchmark runs every size of one benchmark before
+// the next benchmark, so inputs are generated again for each one rather than kept for all sizes.
+inline void drop(const benchmark::State& state) {
+  const auto bytes = static_cast<size_t>(state.range(0));
+  lines().erase(bytes);
+  if (const auto it = files().find(bytes); it != files().end()) {
+    std::error_code error{};
+    std::filesystem::remove(it->second, error);
+    files().erase(it);
+  }
+}
+
+}  // namespace inputs_detail
+
+// Input sizes of the benchmarks over generated inputs: 1KiB, 32KiB, 1MiB and 32MiB, and 1GiB too
+// with AOC_BENCH_HUGE=1. An input lives only while one benchmark runs at its size.
+inline void inputSizes(benchmark::internal::Benchmark* benchmark) {
+  const auto* huge = std::getenv("AOC_BENCH_HUGE");
+  const auto largest = (huge != nullptr && std::string_view{huge} != "0") ? (1 << 30) : (1 << 25);
+  benchmark->RangeMultiplier(32)->Range(1 << 10, largest)->Teardown(inputs_detail::drop);
+}
+
+// 2024/01 style lines of two location ids, "12345   67890\n", cut to at most bytes at a line
+// boundary.
+inline const std::string& numberLines(size_t bytes) {
+  auto& lines = inputs_detail::lines()[bytes];
+
+  if (lines.empty()) {
+    std::mt19937_64 gen{bytes};
+    std::uniform_int_distribution<uint32_t> id{10000, 99999};
+
+    lines.reserve(bytes);
+    while (true) {
+      const auto line = fmt::format("{}   {}\n", id(gen), id(gen));
+      if (lines.size() + line.size() > bytes) {
+        break;
+      }
+      lines += line;
+    }
+  }
+
+  return lines;
+}
+
+// numberLines(bytes) written to a file in the temporary directory.
+inline const std::string& numberFile(size_t bytes) {
+  auto& path = inputs_detail::files()[bytes];
+
+  if (path.empty()) {
+    path = (std::filesystem::temp_directory_path() / fmt::format("aoc_bench_{}.txt", bytes));
+    std::ofstream{path} << numberLines(bytes);
+  }
+
+  return path;
+}
+
+inline size_t countLines(const std::string& str) {
+  return static_cast<size_t>(std::count(str.begin(), str.end(), '\n'));
+}
@@ -0,0 +1,76 @@
+#include "lib/alloc.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace {
+
+class AllocTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    if (!allocProfilerBuilt()) {
+      GTEST_SKIP() << "built without -DAOC_ALLOC_PROFILE";
+    }
+  }
+};
+
+}  // namespace
+
+TEST_F(AllocTest, counts) {
+  startAllocProfile();
+
+  std::vector<std::unique_ptr<std::vector<char>>> blocks{};
+  blocks.reserve(100);
+  for (size_t i = 0; i < 100; ++i) {
+    blocks.emplace_back(std::make_unique<std::vector<char>>(1000));
+  }
+  blocks.clear();
+
+  const auto stats = stopAllocProfile();
+
+  // One for reserve(), then an object and a buffer per block.
+  EXPECT_EQ(stats.allocations, 201);
+  EXPECT_EQ(stats.frees, 200);
+  EXPECT_GE(stats.bytes, 100 * 1000);
+  EXPECT_GE(stats.peakBytes, 100 * 1000);
+  EXPECT_LT(stats.peakBytes, 2 * stats.bytes);
+}
+
+TEST_F(AllocTest, freesFromBefore) {
+  auto before = std::make_unique<std::vector<char>>(100000);
+
+  startAllocProfile();
+  before.reset();
+  const auto block = std::make_unique<std::vector<char>>(1000);
+  const auto stats = stopAllocProfile();
+
+  // The free of the block from before the part counts, but takes nothing off the part's peak.
+  EXPECT_EQ(stats.frees, 2);
+  EXPECT_GE(stats.peakBytes, 1000);
+}
+
+TEST_F(AllocTest, stopped) {
+  startAllocProfile();
+  const auto before = stopAllocProfile();
+
+  const auto block = std::make_unique<std::vector<char>>(1000);
+  EXPECT_EQ(stopAllocProfile().allocations, before.allocations);
+}
+
+TEST_F(AllocTest, aligned) {
+  struct alignas(64) Line {
+    char bytes[64];
+  };
+
+  startAllocProfile();
+  const auto line = std::make_unique<Line>();
+  const auto stats = stopAllocProfile();
+
+  EXPECT_EQ(reinterpret_cast<uintptr_t>(line.get()) % 64, 0);
+  EXPECT_EQ(stats.allocations, 1);
+}
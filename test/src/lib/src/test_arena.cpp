@@ -0,0 +1,38 @@
+#include "lib/arena.h"
+
+#include <cstddef>
+#include <memory_resource>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+TEST(ArenaTest, allocate) {
+  Arena arena{64};
+
+  std::pmr::vector<std::pmr::string> strings{arena.resource()};
+  for (size_t i = 0; i < 1000; ++i) {
+    strings.emplace_back(std::string(100, 'x'));
+  }
+
+  EXPECT_EQ(strings.get_allocator().resource(), arena.resource());
+  EXPECT_EQ(strings.back().get_allocator().resource(), arena.resource());
+  EXPECT_EQ(std::string_view{strings.back()}, std::string(100, 'x'));
+}
+
+TEST(ArenaTest, release) {
+  Arena arena{};
+
+  const auto* first = arena.resource()->allocate(16);
+  arena.release();
+  const auto* second = arena.resource()->allocate(16);
+
+  // Released memory is handed out again rather than growing the arena.
+  EXPECT_EQ(first, second);
+}
+
+TEST(ArenaTest, runArena) {
+  EXPECT_EQ(&runArena(), &runArena());
+  EXPECT_NE(runArena().resource(), nullptr);
+}
@@ -0,0 +1,62 @@
+#include "lib/bench.h"
+
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+TEST(BenchTest, summarize) {
+  std::vector<double> samples{};
+  for (int i = 100; i >= 1; --i) {
+    samples.emplace_back(i);
+  }
+
+  const auto summary = summarize(samples);
+  EXPECT_EQ(summary.min, 1);
+  EXPECT_EQ(summary.median, 50.5);
+  EXPECT_EQ(summary.p90, 90);
+  EXPECT_EQ(summary.p99, 99);
+}
+
+TEST(BenchTest, summarizeFewSamples) {
+  const auto one = summarize({7});
+  EXPECT_EQ(one.min, 7);
+  EXPECT_EQ(one.median, 7);
+  EXPECT_EQ(one.p99, 7);
+
+  const auto three = summarize({3, 1, 2});
+  EXPECT_EQ(three.median, 2);
+  EXPECT_EQ(three.p90, 3);
+
+  EXPECT_THROW(summarize({}), std::invalid_argument);
+}
+
+TEST(BenchTest, clocks) {
+  const auto wall = wallNanos();
+  const auto cpu = cpuNanos();
+
+  volatile double sink = 0;
+  for (int i = 0; i < 1000000; ++i) {
+    sink = sink + i;
+  }
+
+  EXPECT_GT(wallNanos(), wall);
+  EXPECT_GT(cpuNanos(), cpu);
+}
+
+TEST(BenchTest, reportJsonEscapesFile) {
+  // Without --bench-json the JSON line goes to stdout, after the wall and cpu lines.
+  testing::internal::CaptureStdout();
+  reportBench("dir\\\"a\"\tb\x01.cpp", 7, 1, false, {1, 2}, {1, 2});
+  const auto output = testing::internal::GetCapturedStdout();
+
+  EXPECT_NE(output.find(R"("file":"dir\\\"a\"\u0009b\u0001.cpp","line":7,)"), std::string::npos)
+      << output;
+}
+
+TEST(BenchTest, benchOptionsDisabledByDefault) {
+  // The test binary is not started with --bench or AOC_BENCH.
+  EXPECT_EQ(benchOptions().repetitions, 0);
+  EXPECT_EQ(benchOptions().warmups, 0);
+}
@@ -0,0 +1,144 @@
+#include "lib/bitgrid.h"
+
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace {
+
+// Rows of '#' (set) and '.' cells.
+BitGrid fromRows(const std::vector<std::string>& rows) {
+  BitGrid grid{rows.empty() ? 0 : rows.front().size(), rows.size()};
+  for (size_t y = 0; y < rows.size(); ++y) {
+    for (size_t x = 0; x < rows[y].size(); ++x) {
+      if (rows[y][x] == '#') {
+        grid.set(x, y);
+      }
+    }
+  }
+  return grid;
+}
+
+std::vector<std::string> toRows(const BitGrid& grid) {
+  std::vector<std::string> rows(grid.height(), std::string(grid.width(), '.'));
+  grid.forEachSet([&rows](size_t x, size_t y) { rows[y][x] = '#'; });
+  return rows;
+}
+
+// A row wider than one word, with cells on both sides of the word boundary.
+std::string wideRow(const std::vector<size_t>& set, size_t width = 100) {
+  std::string row(width, '.');
+  for (const auto x : set) {
+    row[x] = '#';
+  }
+  return row;
+}
+
+}  // namespace
+
+TEST(BitGridTest, cells) {
+  BitGrid grid{70, 3};
+  EXPECT_EQ(grid.wordsPerRow(), 2);
+  EXPECT_FALSE(grid.any());
+
+  grid.set(0, 0);
+  grid.set(69, 2);
+  EXPECT_TRUE(grid.test(69, 2));
+  EXPECT_FALSE(grid.testAndSet(64, 1));
+  EXPECT_TRUE(grid.testAndSet(64, 1));
+  EXPECT_EQ(grid.count(), 3);
+  EXPECT_EQ(grid.count(1), 1);
+
+  grid.reset(0, 0);
+  EXPECT_FALSE(grid.test(0, 0));
+  EXPECT_EQ(grid.count(), 2);
+  EXPECT_FALSE(grid.contains(70, 0));
+  EXPECT_FALSE(grid.contains(0, static_cast<size_t>(-1)));
+
+  grid.clear();
+  EXPECT_FALSE(grid.any());
+}
+
+TEST(BitGridTest, shift) {
+  auto grid = fromRows({wideRow({0, 62, 63, 99})});
+
+  grid.shiftRow(0, 1);
+  EXPECT_EQ(toRows(grid).front(), wideRow({1, 63, 64}));
+  grid.shiftRow(0, -63);
+  EXPECT_EQ(toRows(grid).front(), wideRow({0, 1}));
+  grid.shiftRow(0, 200);
+  EXPECT_FALSE(grid.any());
+
+  const auto square = fromRows({"##.", "#..", "..."});
+  EXPECT_EQ(toRows(square.shifted(1, 1)), (std::vector<std::string>{"...", ".##", ".#."}));
+  EXPECT_EQ(toRows(square.shifted(-1, 0)), (std::vector<std::string>{"#..", "...", "..."}));
+}
+
+TEST(BitGridTest, setOperations) {
+  const auto lhs = fromRows({"##..", "#.#."});
+  const auto rhs = fromRows({".#.#", "#..#"});
+
+  EXPECT_EQ(toRows(lhs | rhs), (std::vector<std::string>{"##.#", "#.##"}));
+  EXPECT_EQ(toRows(lhs & rhs), (std::vector<std::string>{".#..", "#..."}));
+  EXPECT_EQ(toRows(lhs ^ rhs), (std::vector<std::string>{"#..#", "..##"}));
+  EXPECT_EQ(toRows(BitGrid{lhs}.andNot(rhs)), (std::vector<std::string>{"#...", "..#."}));
+
+  auto around = lhs.shifted(1, 0) | lhs.shifted(-1, 0) | lhs.shifted(0, 1) | lhs.shifted(0, -1);
+  around.andNot(lhs);
+  EXPECT_EQ(toRows(around), (std::vector<std::string>{"..#.", ".#.#"}));
+
+  EXPECT_THROW(BitGrid{lhs} |= BitGrid(4, 3), std::invalid_argument);
+}
+
+TEST(BitGridTest, reflectAndTranspose) {
+  const auto grid = fromRows({"##.", "..#"});
+  EXPECT_EQ(toRows(grid.reflectedX()), (std::vector<std::string>{".##", "#.."}));
+  EXPECT_EQ(toRows(grid.reflectedY()), (std::vector<std::string>{"..#", "##."}));
+  EXPECT_EQ(toRows(grid.transposed()), (std::vector<std::string>{"#.", "#.", ".#"}));
+  EXPECT_EQ(grid.transposed().transposed(), grid);
+
+  const auto wide = fromRows({wideRow({0, 1, 64, 99})});
+  EXPECT_EQ(toRows(wide.reflectedX()).front(), wideRow({0, 35, 98, 99}));
+}
+
+TEST(BitGridTest, fold) {
+  // adventofcode.com/2021/day/13
+  const auto paper = fromRows({
+      "...#..#..#.",
+      "....#......",
+      "...........",
+      "#..........",
+      "...#....#.#",
+      "...........",
+      "...........",
+      "...........",
+      "...........",
+      "...........",
+      ".#....#.##.",
+      "....#......",
+      "......#...#",
+      "#..........",
+      "#.#........",
+  });
+
+  const auto once = paper.foldedY(7);
+  EXPECT_EQ(once.count(), 17);
+  EXPECT_EQ(toRows(once.foldedX(5)), (std::vector<std::string>{
+                                         "#####",
+                                         "#...#",
+                                         "#...#",
+                                         "#...#",
+                                         "#####",
+                                         ".....",
+                                         ".....",
+                                     }));
+
+  // The larger part decides the size, and the fold line is dropped.
+  EXPECT_EQ(toRows(fromRows({"#.#..#"}).foldedX(1)), (std::vector<std::string>{"#..#"}));
+  EXPECT_EQ(toRows(fromRows({"#..#.#"}).foldedX(4)), (std::vector<std::string>{"#..#"}));
+  EXPECT_EQ(toRows(fromRows({wideRow({0, 99})}).foldedX(70)).front(), wideRow({0, 41}, 70));
+}
@@ -0,0 +1,101 @@
+#include "lib/cycle.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <set>
+#include <utility>
+
+#include "gtest/gtest.h"
+
+namespace {
+
+// x -> (x^2 + c) mod m, which runs into a cycle after a tail.
+struct Quadratic final {
+  uint64_t c;
+  uint64_t m;
+
+  void operator()(uint64_t& x) const { x = ((x * x) + c) % m; }
+};
+
+// (tail, period) of the sequence from x, by remembering every value.
+std::pair<size_t, size_t> bruteForce(uint64_t x, const Quadratic& step) {
+  std::map<uint64_t, size_t> seen{};
+  for (size_t i = 0;; ++i) {
+    if (const auto [it, inserted] = seen.emplace(x, i); !inserted) {
+      return {it->second, i - it->second};
+    }
+    step(x);
+  }
+}
+
+}  // namespace
+
+TEST(CycleTest, zobristKeys) {
+  std::set<uint64_t> keys{};
+  for (uint64_t feature = 0; feature < 100000; ++feature) {
+    keys.insert(zobristKey(feature));
+  }
+  EXPECT_EQ(keys.size(), 100000);
+}
+
+TEST(CycleTest, finder) {
+  for (uint64_t c = 1; c < 50; ++c) {
+    const Quadratic step{.c = c, .m = 10007};
+    const auto [tail, period] = bruteForce(2, step);
+
+    uint64_t x = 2;
+    CycleFinder<uint64_t> finder{x, zobristKey(x)};
+    size_t found = 0;
+    while (found == 0) {
+      step(x);
+      found = finder.next(x, zobristKey(x));
+    }
+    EXPECT_EQ(found, period) << c;
+    EXPECT_LE(finder.steps(), (2 * std::max(tail, period)) + period) << c;
+    EXPECT_EQ(finder.collisions(), 0) << c;
+  }
+}
+
+TEST(CycleTest, collisions) {
+  // Every state has the same fingerprint, so only comparing the states finds the period.
+  const Quadratic step{.c = 3, .m = 1009};
+  const auto period = bruteForce(5, step).second;
+
+  uint64_t x = 5;
+  CycleFinder<uint64_t> finder{x, 0};
+  size_t found = 0;
+  while (found == 0) {
+    step(x);
+    found = finder.next(x, 0);
+  }
+  EXPECT_EQ(found, period);
+  EXPECT_GT(finder.collisions(), 0);
+}
+
+TEST(CycleTest, fastForward) {
+  const Quadratic step{.c = 7, .m = 100003};
+  const auto [tail, period] = bruteForce(1, step);
+  const auto fingerprint = [](uint64_t x) { return zobristKey(x); };
+
+  // The state after n steps is the one after the step n comes round to within the first cycle.
+  const auto expected = [&step, tail, period](size_t n) {
+    const auto steps = (n < tail) ? n : tail + ((n - tail) % period);
+    uint64_t x = 1;
+    for (size_t i = 0; i < steps; ++i) {
+      step(x);
+    }
+    return x;
+  };
+
+  for (const size_t n : {size_t{0}, size_t{1}, tail, tail + period + 1, size_t{1000000000}}) {
+    uint64_t x = 1;
+    const auto found = fastForward(x, n, step, fingerprint);
+    EXPECT_EQ(x, expected(n)) << n;
+    EXPECT_TRUE(found == 0 || found == period) << n;
+  }
+
+  uint64_t x = 1;
+  EXPECT_EQ(fastForward(x, 1000000000, step, fingerprint), period);
+}
@@ -0,0 +1,59 @@
+#include "lib/delim.h"
+
+#include <cstddef>
+#include <random>
+#include <string>
+#include <string_view>
+
+#include "gtest/gtest.h"
+
+namespace {
+
+std::string randomString(size_t size, std::string_view alphabet, unsigned seed) {
+  std::mt19937 gen{seed};
+  std::uniform_int_distribution<size_t> dist{0, alphabet.size() - 1};
+
+  std::string str(size, '\0');
+  for (auto& c : str) {
+    c = alphabet[dist(gen)];
+  }
+
+  return str;
+}
+
+}  // namespace
+
+TEST(DelimTest, charClass) {
+  constexpr CharClass kClass{"=, \n"};
+
+  static_assert(kClass.contains('='));
+  static_assert(kClass.contains('\n'));
+  static_assert(!kClass.contains('a'));
+  EXPECT_TRUE(kClass.contains(' '));
+  EXPECT_FALSE(kClass.contains('\0'));
+  EXPECT_FALSE(CharClass{"a"}.contains(static_cast<char>(0xe1)));
+}
+
+TEST(DelimTest, findAnyOf) {
+  for (unsigned seed = 0; seed < 64; ++seed) {
+    const auto str = randomString(seed * 7, "abcdefgh=, ", seed);
+
+    for (size_t pos = 0; pos <= str.size(); pos += 3) {
+      EXPECT_EQ(findAnyOf<"=, ">(str, pos), str.find_first_of("=, ", pos));
+      EXPECT_EQ(findNotAnyOf<"=, ">(str, pos), str.find_first_not_of("=, ", pos));
+    }
+  }
+}
+
+TEST(DelimTest, findSubstr) {
+  for (unsigned seed = 0; seed < 64; ++seed) {
+    const auto str = randomString(seed * 5, "ab\n", seed);
+
+    for (size_t pos = 0; pos <= str.size(); pos += 2) {
+      EXPECT_EQ(findSubstr<"\n">(str, pos), str.find("\n", pos));
+      EXPECT_EQ(findSubstr<"\n\n">(str, pos), str.find("\n\n", pos));
+      EXPECT_EQ(findSubstr<"a\nb">(str, pos), str.find("a\nb", pos));
+      EXPECT_EQ(findSubstr<"ab\nab">(str, pos), str.find("ab\nab", pos));
+    }
+  }
+}
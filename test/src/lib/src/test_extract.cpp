@@ -0,0 +1,75 @@
+#include "lib/extract.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <sys/types.h>
+
+#include "gtest/gtest.h"
+
+namespace {
+
+template <class T>
+std::vector<T> extractAll(std::string_view str) {
+  std::vector<T> ints{};
+  extractInts<T>(str, std::back_inserter(ints));
+  return ints;
+}
+
+}  // namespace
+
+TEST(ExtractTest, extractInts) {
+  EXPECT_EQ(extractAll<ssize_t>("p=0,4 v=3,-3"), (std::vector<ssize_t>{0, 4, 3, -3}));
+  EXPECT_EQ(extractAll<size_t>("Button A: X+94, Y+34"), (std::vector<size_t>{94, 34}));
+  EXPECT_EQ(extractAll<int>("0,9 -> 5,9"), (std::vector<int>{0, 9, 5, 9}));
+  EXPECT_EQ(extractAll<int>("1-3 a: abcde"), (std::vector<int>{1, -3}));
+  EXPECT_EQ(extractAll<unsigned>("1-3 a: abcde"), (std::vector<unsigned>{1, 3}));
+  EXPECT_EQ(extractAll<int>("--7"), (std::vector<int>{-7}));
+  EXPECT_EQ(extractAll<int>("no numbers here"), (std::vector<int>{}));
+  EXPECT_EQ(extractAll<int>(""), (std::vector<int>{}));
+  EXPECT_EQ(extractAll<int64_t>("x 123456789012345678 y"),
+            (std::vector<int64_t>{123456789012345678}));
+  EXPECT_EQ(extractAll<uint64_t>("1 99999999999999999999999 2"), (std::vector<uint64_t>{1, 2}));
+}
+
+TEST(ExtractTest, extractIntsAcrossVectorWidths) {
+  // Digit runs at every offset relative to the vector loads, including ones straddling them.
+  for (size_t padding = 0; padding < 70; ++padding) {
+    const auto str = std::string(padding, '.') + "12345," + std::string(padding, ' ') + "-678";
+    EXPECT_EQ(extractAll<int>(str), (std::vector<int>{12345, -678})) << str;
+  }
+}
+
+TEST(ExtractTest, extractIntColumns) {
+  const auto columns =
+      extractIntColumns<ssize_t>("p=0,4 v=3,-3\np=6,3 v=-1,-3\np=10,3 v=-1,2\n", 4);
+  ASSERT_EQ(columns.rows(), 3);
+  ASSERT_EQ(columns.columns(), 4);
+  EXPECT_EQ(std::vector<ssize_t>(columns.column(0).begin(), columns.column(0).end()),
+            (std::vector<ssize_t>{0, 6, 10}));
+  EXPECT_EQ(std::vector<ssize_t>(columns.column(3).begin(), columns.column(3).end()),
+            (std::vector<ssize_t>{-3, -3, 2}));
+  EXPECT_EQ(columns(1, 2), -1);
+}
+
+TEST(ExtractTest, extractIntColumnsSkipsLinesWithoutInts) {
+  const auto columns = extractIntColumns<size_t>("seed-to-soil map:\n50 98 2\n52 50 48\n\n", 3);
+  ASSERT_EQ(columns.rows(), 2);
+  EXPECT_EQ(std::vector<size_t>(columns.column(0).begin(), columns.column(0).end()),
+            (std::vector<size_t>{50, 52}));
+  EXPECT_EQ(std::vector<size_t>(columns.column(1).begin(), columns.column(1).end()),
+            (std::vector<size_t>{98, 50}));
+  EXPECT_EQ(std::vector<size_t>(columns.column(2).begin(), columns.column(2).end()),
+            (std::vector<size_t>{2, 48}));
+
+  EXPECT_EQ(extractIntColumns<int>("", 2).rows(), 0);
+}
+
+TEST(ExtractTest, extractIntColumnsThrowsOnWrongCount) {
+  EXPECT_THROW(extractIntColumns<int>("1 2\n3\n", 2), std::runtime_error);
+  EXPECT_THROW(extractIntColumns<int>("1 2\n3 4 5\n", 2), std::runtime_error);
+}
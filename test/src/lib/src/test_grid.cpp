@@ -0,0 +1,192 @@
+#include "lib/grid.h"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+TEST(GridTest, layout) {
+  const CharGrid grid{"ab\ncd\nef", 1, '#'};
+
+  EXPECT_EQ(grid.width(), 2);
+  EXPECT_EQ(grid.height(), 3);
+  EXPECT_EQ(grid.stride(), 4);
+  EXPECT_EQ(grid.size(), 20);
+  EXPECT_EQ(grid.cells(), "#####ab##cd##ef#####");
+
+  EXPECT_EQ(grid.at(0, 0), 'a');
+  EXPECT_EQ(grid.at(1, 2), 'f');
+  EXPECT_EQ(grid.row(1), "cd");
+
+  const auto i = grid.find('d');
+  EXPECT_EQ(i, grid.index(1, 1));
+  EXPECT_EQ(grid.x(i), 1);
+  EXPECT_EQ(grid.y(i), 1);
+  EXPECT_TRUE(grid.inside(i));
+}
+
+TEST(GridTest, move) {
+  const CharGrid grid{"abc\ndef\nghi", 2, '.'};
+  const auto center = grid.find('e');
+
+  EXPECT_EQ(grid[grid.move(center, CharGrid::kUp)], 'b');
+  EXPECT_EQ(grid[grid.move(center, CharGrid::kRight)], 'f');
+  EXPECT_EQ(grid[grid.move(center, CharGrid::kDown)], 'h');
+  EXPECT_EQ(grid[grid.move(center, CharGrid::kLeft)], 'd');
+
+  // Walking off any edge lands on the sentinel, border deep.
+  auto i = grid.find('a');
+  i = grid.move(i, CharGrid::kLeft);
+  EXPECT_EQ(grid[i], '.');
+  EXPECT_FALSE(grid.inside(i));
+  i = grid.move(grid.move(i, CharGrid::kUp), CharGrid::kUp);
+  EXPECT_EQ(grid[i], '.');
+  EXPECT_EQ(i, 1);
+}
+
+TEST(GridTest, mutate) {
+  CharGrid grid{"..\n..", 1, '#'};
+  grid.at(1, 0) = 'X';
+  grid[grid.index(0, 1)] = 'Y';
+  EXPECT_EQ(grid.row(0), ".X");
+  EXPECT_EQ(grid.row(1), "Y.");
+}
+
+TEST(GridTest, trailingNewline) {
+  const CharGrid grid{"ab\ncd\n", 1, '#'};
+  EXPECT_EQ(grid.height(), 2);
+  EXPECT_EQ(grid.row(1), "cd");
+
+  EXPECT_EQ((CharGrid{"ab\r\ncd\r\n", 1, '#'}).cells(), "#####ab##cd#####");
+  EXPECT_THROW((CharGrid{"ab\ncd\n\n", 1, '#'}), std::invalid_argument);
+}
+
+TEST(GridTest, invalid) {
+  EXPECT_THROW((CharGrid{"ab\nc", 1, '#'}), std::invalid_argument);
+
+  const CharGrid empty{"", 1, '#'};
+  EXPECT_EQ(empty.width(), 0);
+  EXPECT_EQ(empty.height(), 0);
+  EXPECT_EQ(empty.find('.'), std::string::npos);
+}
+
+TEST(GridTest, readGrid) {
+  const auto path = (std::filesystem::temp_directory_path() / "aoc_test_grid.txt").string();
+  std::ofstream{path} << "#.#\r\n.^.\r\n#.#\r\n";
+
+  const auto grid = readGrid(path, 1, ' ');
+  EXPECT_EQ(grid.width(), 3);
+  EXPECT_EQ(grid.height(), 3);
+  EXPECT_EQ(grid.x(grid.find('^')), 1);
+  EXPECT_EQ(grid.y(grid.find('^')), 1);
+  EXPECT_EQ(grid.row(2), "#.#");
+
+  std::remove(path.c_str());
+}
+
+TEST(GridTest, denseLayout) {
+  Grid<uint8_t> grid{3, 2, 7};
+
+  EXPECT_EQ(grid.width(), 3);
+  EXPECT_EQ(grid.height(), 2);
+  EXPECT_EQ(grid.stride(), 64);
+  EXPECT_EQ(grid.size(), 128);
+  EXPECT_EQ(reinterpret_cast<uintptr_t>(grid.row(1).data()) % Grid<uint8_t>::kAlignment, 0);
+
+  grid.at(2, 1) = 9;
+  const auto i = grid.index(2, 1);
+  EXPECT_EQ(grid[i], 9);
+  EXPECT_EQ(grid.x(i), 2);
+  EXPECT_EQ(grid.y(i), 1);
+  EXPECT_TRUE(grid.inside(i));
+  EXPECT_FALSE(grid.inside(grid.index(3, 1)));
+  EXPECT_EQ((std::vector<uint8_t>{grid.row(1).begin(), grid.row(1).end()}),
+            (std::vector<uint8_t>{7, 7, 9}));
+
+  // Cells that do not divide a cache line are not padded.
+  const Grid<std::array<char, 3>> odd{5, 2};
+  EXPECT_EQ(odd.stride(), 5);
+}
+
+TEST(GridTest, denseNeighbours) {
+  const Grid<int> grid{3, 3};
+
+  size_t inside = 0;
+  for (const auto offset : kNeighbours8) {
+    inside += (grid.neighbour(0, 0, offset) != Grid<int>::npos) ? 1 : 0;
+  }
+  EXPECT_EQ(inside, 3);
+
+  EXPECT_EQ(grid.neighbour(1, 1, kNeighbours4[CharGrid::kUp]), grid.index(1, 0));
+  EXPECT_EQ(grid.neighbour(1, 1, kNeighbours4[CharGrid::kRight]), grid.index(2, 1));
+  EXPECT_EQ(grid.neighbour(1, 1, kNeighbours4[CharGrid::kDown]), grid.index(1, 2));
+  EXPECT_EQ(grid.neighbour(1, 1, kNeighbours4[CharGrid::kLeft]), grid.index(0, 1));
+  EXPECT_EQ(grid.neighbour(2, 2, kNeighbours4[CharGrid::kRight]), Grid<int>::npos);
+}
+
+TEST(GridTest, denseCopyAndColumns) {
+  Grid<int> grid{2, 3};
+  grid.forEachCell([](size_t x, size_t y, int& cell) { cell = static_cast<int>((10 * y) + x); });
+
+  auto copy = grid;
+  copy.at(0, 0) = -1;
+  EXPECT_EQ(grid.at(0, 0), 0);
+
+  std::vector<int> column{};
+  for (const auto cell : grid.column(1)) {
+    column.push_back(cell);
+  }
+  EXPECT_EQ(column, (std::vector<int>{1, 11, 21}));
+
+  for (auto& cell : copy.column(0)) {
+    cell = 5;
+  }
+  EXPECT_EQ(copy.at(0, 2), 5);
+
+  copy.fill(3);
+  EXPECT_EQ(copy.at(1, 1), 3);
+}
+
+TEST(GridTest, denseMove) {
+  Grid<uint64_t> grid{8, 8, 1};
+  auto moved = std::move(grid);
+  EXPECT_EQ(moved.size(), 64);
+  EXPECT_EQ(moved.at(7, 7), 1);
+
+  // The source is left empty, and still safe to copy, fill and assign to.
+  EXPECT_EQ(grid.size(), 0);
+  EXPECT_EQ(grid.width(), 0);
+  auto copy = grid;
+  copy.fill(2);
+  EXPECT_EQ(copy.size(), 0);
+
+  grid = std::move(moved);
+  EXPECT_EQ(grid.at(3, 3), 1);
+  EXPECT_EQ(moved.height(), 0);
+}
+
+TEST(GridTest, denseForEachCellParallel) {
+  const Grid<int> grid{100, 37, 1};
+
+  std::atomic<int> sum{0};
+  grid.forEachCell([&sum](size_t, size_t, int cell) { sum += cell; }, 4);
+  EXPECT_EQ(sum, 3700);
+
+  EXPECT_THROW(grid.forEachCell(
+                   [](size_t, size_t y, int) {
+                     if (y == 30) {
+                       throw std::runtime_error("row 30");
+                     }
+                   },
+                   4),
+               std::runtime_error);
+}
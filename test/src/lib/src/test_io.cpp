@@ -0,0 +1,181 @@
+#include "lib/io.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <sys/types.h>
+#include <unistd.h>
+
+#include <fmt/format.h>
+#include "gtest/gtest.h"
+
+namespace {
+
+std::string writeTemp(const std::string& name, const std::string& contents) {
+  const auto path = (std::filesystem::temp_directory_path() / name).string();
+  std::ofstream{path} << contents;
+  return path;
+}
+
+}  // namespace
+
+TEST(IoTest, read) {
+  const auto path = writeTemp("aoc_test_io_read.txt", "\n  hello\nworld \n\n");
+
+  EXPECT_EQ(read(path), "hello\nworld");
+  EXPECT_EQ(read(path, false), "\n  hello\nworld \n\n");
+
+  std::remove(path.c_str());
+}
+
+TEST(IoTest, readMapped) {
+  const auto path = writeTemp("aoc_test_io_read_mapped.txt", " 1 2\n3 4\n");
+
+  const auto file = readMapped(path);
+  EXPECT_TRUE(file.mapped());
+  EXPECT_EQ(file.view(), "1 2\n3 4");
+  EXPECT_EQ(readMapped(path, false).view(), " 1 2\n3 4\n");
+
+  std::remove(path.c_str());
+}
+
+TEST(IoTest, readMappedEmpty) {
+  const auto path = writeTemp("aoc_test_io_read_mapped_empty.txt", "");
+
+  const auto file = readMapped(path);
+  EXPECT_FALSE(file.mapped());
+  EXPECT_EQ(file.view(), "");
+
+  std::remove(path.c_str());
+}
+
+TEST(IoTest, readMappedPipe) {
+  std::array<int, 2> fds = {};
+  ASSERT_EQ(::pipe(fds.data()), 0);
+  const std::string contents = "  piped\ndata\n";
+  ASSERT_EQ(::write(fds[1], contents.data(), contents.size()),
+            static_cast<ssize_t>(contents.size()));
+  ::close(fds[1]);
+
+  const auto file = readMapped(fmt::format("/dev/fd/{}", fds[0]));
+  EXPECT_FALSE(file.mapped());
+  EXPECT_EQ(file.view(), "piped\ndata");
+
+  ::close(fds[0]);
+}
+
+TEST(IoTest, mappedFileMove) {
+  const auto path = writeTemp("aoc_test_io_mapped_file_move.txt", " short ");
+
+  auto file = readMapped(path);
+  const MappedFile moved{std::move(file)};
+  EXPECT_EQ(moved.view(), "short");
+  EXPECT_EQ(file.view(), "");
+
+  std::remove(path.c_str());
+}
+
+TEST(IoTest, forEachLine) {
+  const std::string contents = "1 2\n33 44\n\n555 666\n7\n";
+  const auto path = writeTemp("aoc_test_io_for_each_line.txt", contents);
+  const std::vector<std::string> expected = {"1 2", "33 44", "", "555 666", "7"};
+
+  for (size_t chunkSize = 1; chunkSize <= contents.size() + 1; ++chunkSize) {
+    std::vector<std::string> lines{};
+    forEachLine(path, [&lines](std::string_view line) { lines.emplace_back(line); }, chunkSize);
+    EXPECT_EQ(lines, expected) << "chunkSize: " << chunkSize;
+  }
+
+  std::remove(path.c_str());
+}
+
+TEST(IoTest, forEachRecord) {
+  std::string contents{};
+  std::vector<std::string> expected{};
+  for (size_t i = 0; i < 20; ++i) {
+    expected.emplace_back(fmt::format("Button A: X+{}, Y+{}\nPrize: X={}", i, i * 3, i * 77));
+    contents += expected.back() + "\n\n";
+  }
+  const auto path = writeTemp("aoc_test_io_for_each_record.txt", contents);
+
+  for (const size_t chunkSize : {1UL, 2UL, 3UL, 16UL, 31UL, 4096UL}) {
+    std::vector<std::string> records{};
+    forEachRecord(
+        path, "\n\n", [&records](std::string_view record) { records.emplace_back(record); },
+        chunkSize);
+    EXPECT_EQ(records, expected) << "chunkSize: " << chunkSize;
+  }
+
+  std::remove(path.c_str());
+}
+
+TEST(IoTest, forEachLinePipe) {
+  std::array<int, 2> fds = {};
+  ASSERT_EQ(::pipe(fds.data()), 0);
+  const std::string contents = "a\nbb\nccc";
+  ASSERT_EQ(::write(fds[1], contents.data(), contents.size()),
+            static_cast<ssize_t>(contents.size()));
+  ::close(fds[1]);
+
+  std::vector<std::string> lines{};
+  forEachLine(
+      fmt::format("/dev/fd/{}", fds[0]),
+      [&lines](std::string_view line) { lines.emplace_back(line); }, 2);
+  EXPECT_EQ(lines, (std::vector<std::string>{"a", "bb", "ccc"}));
+
+  ::close(fds[0]);
+}
+
+TEST(IoTest, forEachLineThrows) {
+  const auto path = writeTemp("aoc_test_io_for_each_line_throws.txt", "1\n2\n3\n4\n");
+
+  size_t count = 0;
+  EXPECT_THROW(forEachLine(
+                   path,
+                   [&count](std::string_view) {
+                     if (++count == 2) {
+                       throw std::runtime_error("stop");
+                     }
+                   },
+                   2),
+               std::runtime_error);
+  EXPECT_EQ(count, 2);
+  EXPECT_THROW(forEachLine("/nonexistent/aoc", [](std::string_view) {}), std::runtime_error);
+
+  std::remove(path.c_str());
+}
+
+TEST(IoTest, dataDir) {
+  const auto path = writeTemp("aoc_test_io_data_dir.txt", "data\n");
+  const auto dir = std::filesystem::temp_directory_path().string();
+
+  EXPECT_EQ(resolvePath("aoc_test_io_data_dir.txt"), "aoc_test_io_data_dir.txt");
+
+  setDataDir(dir);
+  EXPECT_EQ(resolvePath("aoc_test_io_data_dir.txt"), path);
+  EXPECT_EQ(resolvePath("/abs/path"), "/abs/path");
+  EXPECT_EQ(resolvePath("-"), "-");
+  EXPECT_EQ(read("aoc_test_io_data_dir.txt"), "data");
+  EXPECT_EQ(readMapped("aoc_test_io_data_dir.txt").view(), "data");
+
+  size_t lines = 0;
+  forEachLine("aoc_test_io_data_dir.txt", [&lines](std::string_view) { ++lines; });
+  EXPECT_EQ(lines, 1);
+
+  // Only the calling thread's paths are resolved against it.
+  std::thread{[] { EXPECT_EQ(resolvePath("a.txt"), "a.txt"); }}.join();
+
+  setDataDir({});
+  EXPECT_EQ(resolvePath("aoc_test_io_data_dir.txt"), "aoc_test_io_data_dir.txt");
+
+  std::remove(path.c_str());
+}
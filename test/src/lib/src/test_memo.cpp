@@ -0,0 +1,123 @@
+#include "lib/memo.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace {
+
+struct Cell final {
+  uint32_t x;
+  uint32_t y;
+};
+
+struct PackCell final {
+  uint64_t operator()(const Cell& cell) const { return (uint64_t{cell.y} << 32) | cell.x; }
+};
+
+// Lattice paths from (0, 0) to (x, y), which recurses deep enough to rehash while computing.
+uint64_t paths(Memo<Cell, uint64_t, PackCell>& memo, Cell cell) {
+  if (cell.x == 0 || cell.y == 0) {
+    return 1;
+  }
+  return memo.get(cell, [&] {
+    return paths(memo, {.x = cell.x - 1, .y = cell.y}) +
+           paths(memo, {.x = cell.x, .y = cell.y - 1});
+  });
+}
+
+// Steps of n's Collatz sequence to 1.
+template <class Table>
+size_t collatz(Table& memo, uint64_t n) {
+  if (n == 1) {
+    return 0;
+  }
+  return memo.get(n, [&] { return 1 + collatz(memo, (n % 2 == 0) ? n / 2 : (3 * n) + 1); });
+}
+
+}  // namespace
+
+TEST(MemoTest, findAndInsert) {
+  Memo<uint64_t, uint64_t> memo{};
+  std::unordered_map<uint64_t, uint64_t> reference{};
+  std::mt19937_64 random{1};
+
+  // Enough keys for several rehashes, some repeated.
+  for (size_t i = 0; i < 20000; ++i) {
+    const auto key = random() % 15000;
+    const auto value = random();
+    memo.insert(key, value);
+    reference.emplace(key, value);
+  }
+
+  EXPECT_EQ(memo.size(), reference.size());
+  for (const auto& [key, value] : reference) {
+    const auto* found = memo.find(key);
+    ASSERT_NE(found, nullptr) << key;
+    EXPECT_EQ(*found, value) << key;
+  }
+  EXPECT_EQ(memo.find(15000), nullptr);
+  EXPECT_EQ(memo.stats().hits, reference.size());
+  EXPECT_EQ(memo.stats().misses, 1);
+
+  memo.clear();
+  EXPECT_TRUE(memo.empty());
+  EXPECT_EQ(memo.find(0), nullptr);
+}
+
+TEST(MemoTest, recursion) {
+  Memo<Cell, uint64_t, PackCell> memo{};
+  EXPECT_EQ(paths(memo, {.x = 16, .y = 16}), 601080390);
+  EXPECT_EQ(memo.size(), 16 * 16);
+  EXPECT_EQ(memo.stats().misses, memo.size());
+
+  const auto before = memo.stats();
+  EXPECT_EQ(paths(memo, {.x = 10, .y = 12}), 646646);
+  EXPECT_EQ(memo.stats().hits, before.hits + 1);
+}
+
+TEST(MemoTest, stats) {
+  const auto before = memoStats();
+  {
+    Memo<uint64_t, size_t> memo{};
+    collatz(memo, 27);
+    collatz(memo, 27);
+    EXPECT_EQ(memo.stats().misses, 111);
+    EXPECT_EQ(memo.stats().hits, 1);
+  }
+  // Destroyed tables still count.
+  const auto after = memoStats();
+  EXPECT_EQ(after.misses - before.misses, 111);
+  EXPECT_EQ(after.hits - before.hits, 1);
+}
+
+TEST(MemoTest, sharded) {
+  Memo<uint64_t, size_t> single{};
+  ShardedMemo<uint64_t, size_t> shared{};
+
+  std::vector<std::thread> threads{};
+  std::vector<std::vector<size_t>> steps(4);
+  for (size_t t = 0; t < steps.size(); ++t) {
+    threads.emplace_back([&shared, &steps, t] {
+      for (uint64_t n = 1 + t; n < 20000; n += 4) {
+        steps[t].push_back(collatz(shared, n));
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  for (size_t t = 0; t < steps.size(); ++t) {
+    for (size_t i = 0; i < steps[t].size(); ++i) {
+      EXPECT_EQ(steps[t][i], collatz(single, 1 + t + (4 * i)));
+    }
+  }
+  EXPECT_EQ(shared.size(), single.size());
+  EXPECT_GT(shared.stats().hits, 0);
+}
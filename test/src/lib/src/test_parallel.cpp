@@ -0,0 +1,74 @@
+#include "lib/parallel.h"
+
+#include <cstddef>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+#include "gtest/gtest.h"
+#include "lib/to.h"
+
+namespace {
+
+std::string numbers(size_t count) {
+  std::string text{};
+  for (size_t i = 1; i <= count; ++i) {
+    text += std::to_string(i) + "\n";
+  }
+  return text;
+}
+
+}  // namespace
+
+TEST(ParallelTest, mapReduceText) {
+  const auto text = numbers(10000);
+  const auto parse = [](std::string_view line) { return to<size_t>(line); };
+
+  for (const size_t threads : {0UL, 1UL, 2UL, 3UL, 8UL, 64UL}) {
+    EXPECT_EQ(mapReduceText(text, parse, std::plus<>{}, threads), 50005000) << threads;
+  }
+}
+
+TEST(ParallelTest, mapReduceTextKeepsLineOrder) {
+  // Concatenation is associative but not commutative, so any reordering would show.
+  const auto text = numbers(500);
+  const auto concat = [](std::string lhs, const std::string& rhs) { return lhs + "," + rhs; };
+  const auto expected =
+      mapReduceText(text, [](std::string_view line) { return std::string{line}; }, concat, 1);
+
+  EXPECT_EQ(
+      mapReduceText(text, [](std::string_view line) { return std::string{line}; }, concat, 7),
+      expected);
+  EXPECT_TRUE(expected.starts_with("1,2,3,"));
+  EXPECT_TRUE(expected.ends_with(",499,500"));
+}
+
+TEST(ParallelTest, mapReduceTextSkipsEmptyLines) {
+  const auto count = [](std::string_view) { return size_t{1}; };
+
+  EXPECT_EQ(mapReduceText("  a \n\n\nb\n   \nc\n", count, std::plus<>{}, 4), 3);
+  EXPECT_EQ(mapReduceText("", count, std::plus<>{}, 4), 0);
+  EXPECT_EQ(mapReduceText("\n\n", count, std::plus<>{}, 4), 0);
+}
+
+TEST(ParallelTest, mapReduceTextRethrows) {
+  const auto text = numbers(1000) + "x\n" + numbers(1000);
+  const auto parse = [](std::string_view line) { return to<size_t>(line); };
+
+  EXPECT_THROW(mapReduceText(text, parse, std::plus<>{}, 4), std::invalid_argument);
+}
+
+TEST(ParallelTest, mapReduceLines) {
+  const auto path = (std::filesystem::temp_directory_path() / "aoc_test_parallel.txt").string();
+  std::ofstream{path} << numbers(100);
+
+  EXPECT_EQ(mapReduceLines(
+                path, [](std::string_view line) { return to<size_t>(line); }, std::plus<>{}, 3),
+            5050);
+
+  std::remove(path.c_str());
+}
@@ -1,6 +1,12 @@
 #include "lib/parse.h"
 
+#include <array>
+#include <cstddef>
+#include <iterator>
+#include <memory_resource>
+#include <stdexcept>
 #include <string>
+#include <string_view>
 #include <utility>
 #include <vector>
 
@@ -27,3 +33,91 @@ TEST(ParseTest, splitToPair) {
   EXPECT_EQ((splitTo<std::pair<std::string, std::string>>("hello world")),
             (splitToPair("hello world")));
 }
+
+TEST(ParseTest, splitViewMatchesSplit) {
+  constexpr auto test = [](const std::string& original, const std::string& delim = " ",
+                           bool delimMultiChar = false, bool trimOriginal = true,
+                           bool trimSplit = true) {
+    const auto view = splitView(original, delim, delimMultiChar, trimOriginal, trimSplit);
+    EXPECT_EQ(splitTo<std::vector<std::string>>(view),
+              split(std::string{original}, delim, delimMultiChar, trimOriginal, trimSplit))
+        << "original: '" << original << "', delim: '" << delim << "'";
+  };
+
+  test("hello world");
+  test("");
+  test("   ");
+  test("a  b   c");
+  test(" a b ", " ", false, false, false);
+  test("p=0,4 v=3,-3", "=, ");
+  test("Register A: 729", "Register:\n");
+  test("1\n2\n\n3\n4", "\n\n", true);
+  test("1\n2\n\n\n\n3\n4\n\n", "\n\n", true, false, false);
+  test("seed-to-soil", "-to-", true);
+  test("a, b , c", ", ", true);
+}
+
+TEST(ParseTest, splitViewLazy) {
+  const std::string original = "1 2 3 4";
+  auto tokens = splitView(original);
+
+  auto it = tokens.begin();
+  EXPECT_EQ(*it, "1");
+  EXPECT_EQ((*it).data(), original.data());
+  EXPECT_EQ(*++it, "2");
+  EXPECT_EQ(std::ranges::distance(tokens), 4);
+  EXPECT_EQ(tokens.front(), "1");
+}
+
+TEST(ParseTest, splitToFromView) {
+  EXPECT_EQ(splitTo<std::vector<size_t>>(splitView("1,2,3", ",")),
+            (std::vector<size_t>{1, 2, 3}));
+  EXPECT_EQ((splitToPair<size_t, size_t>(splitView("3   4"))), (std::pair<size_t, size_t>{3, 4}));
+  EXPECT_EQ((splitToPair(splitView("hello world"))),
+            (std::pair<std::string_view, std::string_view>{"hello", "world"}));
+  EXPECT_EQ((splitToPair<std::string, int>(splitView("x=-5", "="))),
+            (std::pair<std::string, int>{"x", -5}));
+  EXPECT_THROW((splitToPair(splitView("a b c"))), std::runtime_error);
+  EXPECT_THROW((splitToPair(splitView("a"))), std::runtime_error);
+}
+
+TEST(ParseTest, splitStaticMatchesSplit) {
+  const auto expected = [](const std::string& original, const std::string& delim,
+                           bool delimMultiChar = false) {
+    return split(std::string{original}, delim, delimMultiChar);
+  };
+
+  const std::string lines = "1   2\n33 44\n\n\n555 66\n7 8 9\n\n10\n";
+  EXPECT_EQ(splitTo<std::vector<std::string>>(split<"\n">(lines)), expected(lines, "\n"));
+  EXPECT_EQ(splitTo<std::vector<std::string>>(split<" \n">(lines)), expected(lines, " \n"));
+  EXPECT_EQ((splitTo<std::vector<std::string>>(split<"\n\n", true>(lines))),
+            expected(lines, "\n\n", true));
+
+  const std::string robot = "p=0,4 v=3,-3";
+  EXPECT_EQ(splitTo<std::vector<std::string>>(split<"=, ">(robot)), expected(robot, "=, "));
+
+  std::string almanac = "seeds: 79 14 55 13\n\n";
+  for (size_t i = 0; i < 20; ++i) {
+    almanac += "seed-to-soil map:\n50 98 2\n52 50 48\n\n";
+  }
+  EXPECT_EQ((splitTo<std::vector<std::string>>(split<" map:\n", true>(almanac))),
+            expected(almanac, " map:\n", true));
+  EXPECT_EQ((splitToPair<std::string, std::string>(split<"-to-", true>("seed-to-soil"))),
+            (std::pair<std::string, std::string>{"seed", "soil"}));
+}
+
+TEST(ParseTest, splitPmr) {
+  std::array<std::byte, 4096> buffer{};
+  std::pmr::monotonic_buffer_resource resource{buffer.data(), buffer.size(),
+                                               std::pmr::null_memory_resource()};
+
+  const auto tokens = split(" 3   4\n4 3 ", &resource);
+  EXPECT_EQ(tokens, (std::pmr::vector<std::pmr::string>{"3", "4\n4", "3"}));
+  EXPECT_EQ(tokens.get_allocator().resource(), &resource);
+
+  EXPECT_EQ(split("a, b,c", &resource, ", ", true),
+            (std::pmr::vector<std::pmr::string>{"a", "b,c"}));
+
+  EXPECT_EQ((splitTo<std::pmr::vector<size_t>>(split<" \n">("3   4\n4 3"), &resource)),
+            (std::pmr::vector<size_t>{3, 4, 4, 3}));
+}
@@ -0,0 +1,39 @@
+#include "lib/perf.h"
+
+#include <cmath>
+#include <cstddef>
+
+#include "gtest/gtest.h"
+
+TEST(PerfTest, countsOrExplains) {
+  PerfCounters counters{};
+  counters.start();
+
+  volatile size_t sink = 0;
+  for (size_t i = 0; i < 1000000; ++i) {
+    sink = sink + i;
+  }
+
+  const auto counts = counters.stop();
+
+  if (!counters.available()) {
+    // E.g. perf_event_paranoid too high or no PMU in a container.
+    EXPECT_FALSE(counters.error().empty());
+    EXPECT_TRUE(std::isnan(counts.values[PerfCounts::kCycles]));
+    GTEST_SKIP() << counters.error();
+  }
+
+  EXPECT_TRUE(counters.error().empty());
+  EXPECT_GT(counts.values[PerfCounts::kInstructions], 1000000);
+  EXPECT_GT(counts.ipc(), 0);
+}
+
+TEST(PerfTest, derivedMetrics) {
+  PerfCounts counts{};
+  counts.values = {2000, 4000, 40, 4, 8};
+
+  EXPECT_EQ(counts.ipc(), 2);
+  EXPECT_EQ(counts.mpki(PerfCounts::kL1dMisses), 10);
+  EXPECT_EQ(counts.mpki(PerfCounts::kLlcMisses), 1);
+  EXPECT_EQ(counts.mpki(PerfCounts::kBranchMisses), 2);
+}
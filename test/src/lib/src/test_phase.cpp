@@ -0,0 +1,113 @@
+#include "lib/phase.h"
+
+#include <cstddef>
+#include <functional>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "lib/parallel.h"
+
+namespace {
+
+void leaf() {
+  AOC_PHASE("leaf");
+}
+
+void parent(size_t leaves) {
+  AOC_PHASE("parent");
+  for (size_t i = 0; i < leaves; ++i) {
+    leaf();
+  }
+}
+
+}  // namespace
+
+TEST(PhaseTest, disabled) {
+  enablePhases(false);
+  resetPhases();
+
+  parent(3);
+  EXPECT_TRUE(phaseTree().children.empty());
+}
+
+TEST(PhaseTest, tree) {
+  enablePhases(true);
+  resetPhases();
+
+  parent(3);
+  parent(2);
+  leaf();
+
+  const auto& root = phaseTree();
+  ASSERT_EQ(root.children.size(), 2);
+
+  const auto& p = *root.children[0];
+  EXPECT_EQ(std::string_view{p.name}, "parent");
+  EXPECT_EQ(p.calls, 2);
+  ASSERT_EQ(p.children.size(), 1);
+  EXPECT_EQ(std::string_view{p.children[0]->name}, "leaf");
+  EXPECT_EQ(p.children[0]->calls, 5);
+  EXPECT_GE(p.nanos, p.children[0]->nanos);
+
+  EXPECT_EQ(std::string_view{root.children[1]->name}, "leaf");
+  EXPECT_EQ(root.children[1]->calls, 1);
+
+  resetPhases();
+  EXPECT_TRUE(phaseTree().children.empty());
+  enablePhases(false);
+}
+
+TEST(PhaseTest, workers) {
+  enablePhases(true);
+  resetPhases();
+
+  {
+    AOC_PHASE("solve");
+    WorkerPhases phases{3};
+    std::vector<std::thread> workers{};
+    for (size_t i = 1; i < 3; ++i) {
+      workers.emplace_back([&phases, i] {
+        parent(i);
+        phases.collect(i);
+      });
+    }
+    parent(1);
+    for (auto& worker : workers) {
+      worker.join();
+    }
+    phases.merge();
+  }
+
+  const auto& root = phaseTree();
+  ASSERT_EQ(root.children.size(), 1);
+  const auto& solve = *root.children[0];
+  EXPECT_EQ(solve.calls, 1);
+  ASSERT_EQ(solve.children.size(), 1);
+
+  const auto& p = *solve.children[0];
+  EXPECT_EQ(std::string_view{p.name}, "parent");
+  EXPECT_EQ(p.calls, 3);
+  EXPECT_EQ(p.parent, &solve);
+  ASSERT_EQ(p.children.size(), 1);
+  EXPECT_EQ(p.children[0]->calls, 1 + 1 + 2);
+  EXPECT_EQ(p.children[0]->parent, &p);
+
+  resetPhases();
+
+  // Every line's phase is reported, whichever thread mapped it.
+  const auto lines = mapReduceText(
+      "1\n2\n3\n4\n5\n6\n7\n8",
+      [](std::string_view) -> size_t {
+        leaf();
+        return 1;
+      },
+      std::plus<>{}, 4);
+  EXPECT_EQ(lines, 8);
+  ASSERT_EQ(phaseTree().children.size(), 1);
+  EXPECT_EQ(phaseTree().children[0]->calls, 8);
+
+  resetPhases();
+  enablePhases(false);
+}
@@ -0,0 +1,57 @@
+#include "lib/progress.h"
+
+#include <chrono>
+#include <string>
+#include <thread>
+
+#include "gtest/gtest.h"
+
+using namespace std::chrono_literals;
+
+TEST(ProgressTest, counts) {
+  ProgressMonitor monitor{"test", 0ns};
+  progress();
+  progress(4);
+  monitor.stop();
+
+  EXPECT_EQ(progress_detail::state.items.load(), 5);
+  EXPECT_FALSE(cancelled());
+}
+
+TEST(ProgressTest, reports) {
+  testing::internal::CaptureStderr();
+  {
+    ProgressMonitor monitor{"test part", 0ns, 10ms};
+    progressTotal(1000);
+    for (size_t i = 0; i < 10; ++i) {
+      progress(10);
+      std::this_thread::sleep_for(5ms);
+    }
+  }
+  const auto output = testing::internal::GetCapturedStderr();
+
+  EXPECT_NE(output.find("test part: "), std::string::npos);
+  EXPECT_NE(output.find(" / 1.00k items, "), std::string::npos);
+  EXPECT_NE(output.find(" items/s, ETA "), std::string::npos);
+}
+
+TEST(ProgressTest, deadline) {
+  testing::internal::CaptureStderr();
+  ProgressMonitor monitor{"test part", 20ms, 5ms};
+
+  const auto start = std::chrono::steady_clock::now();
+  while (!cancelled() && std::chrono::steady_clock::now() - start < 5s) {
+    progress();
+  }
+  monitor.stop();
+  const auto output = testing::internal::GetCapturedStderr();
+
+  EXPECT_TRUE(cancelled());
+  EXPECT_THROW(throwIfCancelled(), Cancelled);
+  EXPECT_NE(output.find("test part: deadline of 20.00ms passed, cancelling"), std::string::npos);
+
+  // A new part starts uncancelled.
+  const ProgressMonitor next{"next", 0ns};
+  EXPECT_FALSE(cancelled());
+  EXPECT_NO_THROW(throwIfCancelled());
+}
@@ -0,0 +1,56 @@
+#include "lib/rss.h"
+
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+TEST(RssTest, parseSize) {
+  EXPECT_EQ(parseSize("0"), 0);
+  EXPECT_EQ(parseSize("4096"), 4096);
+  EXPECT_EQ(parseSize("64k"), 64UL << 10);
+  EXPECT_EQ(parseSize("512M"), 512UL << 20);
+  EXPECT_EQ(parseSize("8G"), 8UL << 30);
+  EXPECT_EQ(parseSize("2T"), 2UL << 40);
+
+  EXPECT_THROW(parseSize(""), std::invalid_argument);
+  EXPECT_THROW(parseSize("G"), std::invalid_argument);
+  EXPECT_THROW(parseSize("1.5G"), std::invalid_argument);
+  EXPECT_THROW(parseSize("-1"), std::invalid_argument);
+  EXPECT_THROW(parseSize("8GB"), std::invalid_argument);
+}
+
+TEST(RssTest, current) {
+  EXPECT_GT(currentRss(), 0);
+  EXPECT_GE(peakRss(), currentRss());
+}
+
+TEST(RssTest, watchdogPeak) {
+  constexpr size_t kSize = 64UL << 20;
+
+  RssWatchdog watchdog{"test", 0};
+  const auto before = currentRss();
+  {
+    // Touch every page, so that they are resident.
+    std::vector<char> buffer(kSize, 1);
+    EXPECT_GE(currentRss(), before + (kSize / 2));
+  }
+  EXPECT_GE(watchdog.stop(), before + (kSize / 2));
+}
+
+namespace {
+
+void exceedBudget() {
+  constexpr size_t kSize = 64UL << 20;
+
+  RssWatchdog watchdog{"test part", currentRss() + (kSize / 4)};
+  const std::vector<char> buffer(kSize, 1);
+  watchdog.stop();
+}
+
+}  // namespace
+
+TEST(RssTest, watchdogBudget) {
+  EXPECT_DEATH(exceedBudget(), "test part: resident set .* exceeds the budget of .*, aborting");
+}
@@ -0,0 +1,53 @@
+#include "lib/run.h"
+
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace {
+
+size_t parses = 0;
+size_t parts = 0;
+
+std::vector<size_t> parse(const std::string& path) {
+  ++parses;
+  return {path.size(), 2, 3};
+}
+
+size_t sum(const std::vector<size_t>& values) {
+  ++parts;
+  return values[0] + values[1] + values[2];
+}
+
+size_t product(const std::vector<size_t>& values) {
+  ++parts;
+  return values[0] * values[1] * values[2];
+}
+
+}  // namespace
+
+TEST(RunTest, parseOnce) {
+  parses = 0;
+  parts = 0;
+
+  testing::internal::CaptureStdout();
+  run(parse, sum, product, true, 21UL, 96UL);
+  run(parse, sum, product, true, kSkip, 18UL, "abc");
+  const auto output = testing::internal::GetCapturedStdout();
+
+  EXPECT_EQ(parses, 2);
+  EXPECT_EQ(parts, 3);
+  EXPECT_NE(output.find(" parse  example: "), std::string::npos);
+  EXPECT_NE(output.find(" part 1 example: 21\n"), std::string::npos);
+  EXPECT_NE(output.find(" part 2 example: 96\n"), std::string::npos);
+  EXPECT_NE(output.find(" part 2 example: 18\n"), std::string::npos);
+}
+
+TEST(RunTest, parseOnceFails) {
+  testing::internal::CaptureStdout();
+  EXPECT_THROW(run(parse, sum, product, false, 20UL, kSkip), std::runtime_error);
+  testing::internal::GetCapturedStdout();
+}
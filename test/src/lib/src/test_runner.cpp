@@ -0,0 +1,54 @@
+#include "lib/runner.h"
+
+#include <stdexcept>
+#include <string>
+
+#include "gtest/gtest.h"
+#include "lib/run.h"
+
+namespace {
+
+size_t answer(const std::string& path) {
+  return (path == "data/input.txt") ? 42 : 0;
+}
+
+void passingDay() {
+  run(1, answer, false, 42UL);
+  run(2, answer, true, 0UL);
+}
+
+void failingDay() {
+  run(1, answer, false, 43UL);
+}
+
+void throwingDay() {
+  throw std::runtime_error("no input");
+}
+
+}  // namespace
+
+TEST(RunnerTest, runDays) {
+  auto& days = registeredDays();
+  const auto registered = days;
+  days.clear();
+
+  registerDay("1999/01", "/tmp", passingDay);
+  registerDay("1999/02", "/tmp", failingDay);
+  registerDay("1999/03", "/tmp", throwingDay);
+
+  testing::internal::CaptureStdout();
+  EXPECT_EQ(runDays(), 1);
+  const auto output = testing::internal::GetCapturedStdout();
+
+  EXPECT_NE(output.find("1999/01"), std::string::npos);
+  EXPECT_NE(output.find("ok\n"), std::string::npos);
+  EXPECT_NE(output.find("result (42) != expected (43)"), std::string::npos);
+  EXPECT_NE(output.find("no input\n"), std::string::npos);
+  EXPECT_NE(output.find("3 days in "), std::string::npos);
+  EXPECT_NE(output.find(", 2 failed"), std::string::npos);
+
+  // Outside of a runner thread, run() is back to normal.
+  EXPECT_EQ(currentDayTimings(), nullptr);
+
+  days = registered;
+}
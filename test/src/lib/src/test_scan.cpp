@@ -0,0 +1,68 @@
+#include "lib/scan.h"
+
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <tuple>
+
+#include <sys/types.h>
+
+#include "gtest/gtest.h"
+
+TEST(ScanTest, scanInto) {
+  struct Point {
+    ssize_t x;
+    ssize_t y;
+  };
+  Point position{};
+  Point velocity{};
+
+  const auto result = scanInto<"p={},{} v={},{}">("p=0,4 v=3,-3", position.x, position.y,
+                                                  velocity.x, velocity.y);
+  EXPECT_TRUE(result);
+  EXPECT_EQ(result.fields, 4);
+  EXPECT_EQ(position.x, 0);
+  EXPECT_EQ(position.y, 4);
+  EXPECT_EQ(velocity.x, 3);
+  EXPECT_EQ(velocity.y, -3);
+}
+
+TEST(ScanTest, scan) {
+  EXPECT_EQ((scan<"Button {}: X+{}, Y+{}", char, size_t, size_t>("Button A: X+94, Y+34")),
+            (std::tuple<char, size_t, size_t>{'A', 94, 34}));
+  EXPECT_EQ((scan<"Register {}: {}", char, size_t>("Register B: 0")),
+            (std::tuple<char, size_t>{'B', 0}));
+  EXPECT_EQ((scan<"Program: {}", std::string_view>("Program: 0,1,5,4,3,0")),
+            (std::tuple<std::string_view>{"0,1,5,4,3,0"}));
+  EXPECT_EQ((scan<"{}-to-{} map:", std::string, std::string>("seed-to-soil map:")),
+            (std::tuple<std::string, std::string>{"seed", "soil"}));
+  EXPECT_EQ((scan<"{} {}", double, int>("1.5 -2")), (std::tuple<double, int>{1.5, -2}));
+  EXPECT_EQ((scan<"no fields">("no fields")), std::tuple<>{});
+}
+
+TEST(ScanTest, mismatch) {
+  size_t x = 0;
+  size_t y = 0;
+
+  const auto literal = scanInto<"X={}, Y={}">("X=1; Y=2", x, y);
+  EXPECT_FALSE(literal);
+  EXPECT_EQ(literal.fields, 1);
+  EXPECT_EQ(literal.position, 3);
+  EXPECT_EQ(x, 1);
+
+  const auto number = scanInto<"X={}, Y={}">("X=1, Y=z", x, y);
+  EXPECT_FALSE(number);
+  EXPECT_EQ(number.fields, 1);
+  EXPECT_EQ(number.position, 7);
+
+  const auto negative = scanInto<"p={},{}">("p=-3,4", x, y);
+  EXPECT_FALSE(negative);
+  EXPECT_EQ(negative.fields, 0);
+  EXPECT_EQ(negative.position, 2);
+  EXPECT_EQ(x, 1);
+
+  EXPECT_FALSE((scanInto<"X={}, Y={}">("X=1, Y=2 trailing", x, y)));
+  EXPECT_FALSE((scanInto<"X={}, Y={}">("", x, y)));
+  EXPECT_EQ((scan<"{},{}", int, int>("1,")), std::nullopt);
+}
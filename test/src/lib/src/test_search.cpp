@@ -0,0 +1,188 @@
+#include "lib/search.h"
+
+#include <array>
+#include <cstddef>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace {
+
+// Open cells ('.') of a maze, 4-connected; state = (y * width) + x.
+struct Maze final {
+  std::vector<std::string> rows;
+
+  size_t width() const { return rows.front().size(); }
+  size_t states() const { return rows.size() * width(); }
+  size_t state(size_t x, size_t y) const { return (y * width()) + x; }
+
+  template <class Visit>
+  void neighbours(size_t from, const Visit& visit) const {
+    const auto x = from % width();
+    const auto y = from / width();
+    const auto open = [this](size_t nx, size_t ny) {
+      return ny < rows.size() && nx < width() && rows[ny][nx] == '.';
+    };
+    const std::array<std::pair<size_t, size_t>, 4> next{
+        {{x + 1, y}, {x - 1, y}, {x, y + 1}, {x, y - 1}}};
+    for (const auto& [nx, ny] : next) {
+      if (open(nx, ny)) {
+        visit(state(nx, ny));
+      }
+    }
+  }
+};
+
+const Maze kMaze{{
+    ".....",
+    ".###.",
+    ".#...",
+    ".#.#.",
+    "...#.",
+}};
+
+using WeightedEdges = std::vector<std::vector<std::pair<size_t, size_t>>>;
+
+// Reference distances by Bellman-Ford.
+std::vector<size_t> bellmanFord(const WeightedEdges& edges, size_t source) {
+  std::vector<size_t> distance(edges.size(), kUnreached);
+  distance[source] = 0;
+  for (size_t round = 0; round < edges.size(); ++round) {
+    for (size_t from = 0; from < edges.size(); ++from) {
+      for (const auto& [to, weight] : edges[from]) {
+        if (distance[from] != kUnreached && distance[from] + weight < distance[to]) {
+          distance[to] = distance[from] + weight;
+        }
+      }
+    }
+  }
+  return distance;
+}
+
+WeightedEdges randomGraph(size_t states, size_t edgesPerState, size_t maxWeight, unsigned seed) {
+  std::mt19937 random{seed};
+  std::uniform_int_distribution<size_t> state{0, states - 1};
+  std::uniform_int_distribution<size_t> weight{0, maxWeight};
+
+  WeightedEdges edges(states);
+  for (auto& out : edges) {
+    for (size_t i = 0; i < edgesPerState; ++i) {
+      out.emplace_back(state(random), weight(random));
+    }
+  }
+  return edges;
+}
+
+}  // namespace
+
+TEST(SearchTest, bfs) {
+  const auto neighbours = [](size_t state, const auto& visit) { kMaze.neighbours(state, visit); };
+
+  const auto all = bfs(kMaze.states(), {kMaze.state(0, 0)}, neighbours);
+  EXPECT_EQ(all.distance(kMaze.state(4, 4)), 8);
+  EXPECT_EQ(all.distance(kMaze.state(2, 4)), 6);
+  EXPECT_EQ(all.distance(kMaze.state(2, 3)), 7);
+  EXPECT_FALSE(all.reached(kMaze.state(1, 1)));
+  EXPECT_EQ(all.goal(), kUnreached);
+
+  const auto end = kMaze.state(4, 4);
+  const auto stopped =
+      bfs(kMaze.states(), {kMaze.state(0, 0)}, neighbours, [end](size_t s) { return s == end; });
+  EXPECT_EQ(stopped.goal(), end);
+  EXPECT_EQ(stopped.distance(end), 8);
+
+  // Two sources: every cell is as far as the nearer one.
+  const auto both = bfs(kMaze.states(), {kMaze.state(0, 0), kMaze.state(4, 4)}, neighbours);
+  EXPECT_EQ(both.distance(kMaze.state(4, 0)), 4);
+  EXPECT_EQ(both.distance(kMaze.state(2, 3)), 5);
+}
+
+TEST(SearchTest, shortestPaths) {
+  // Both ways round the block from the top left to the bottom right are 6 steps.
+  const Maze maze{{
+      "....",
+      ".##.",
+      ".##.",
+      "....",
+  }};
+  const auto neighbours = [&maze](size_t state, const auto& visit) {
+    maze.neighbours(state, visit);
+  };
+
+  const auto end = maze.state(3, 3);
+  const auto result = bfs(
+      maze.states(), {maze.state(0, 0)}, neighbours, [end](size_t s) { return s == end; }, true);
+  EXPECT_EQ(result.distance(end), 6);
+  EXPECT_EQ(result.onShortestPaths({end}).size(), 12);
+
+  const auto corner = maze.state(3, 0);
+  EXPECT_EQ(result.onShortestPaths({corner}),
+            (std::vector<size_t>{maze.state(0, 0), maze.state(1, 0), maze.state(2, 0), corner}));
+}
+
+TEST(SearchTest, weightedMatchesBellmanFord) {
+  for (unsigned seed = 0; seed < 20; ++seed) {
+    const auto edges = randomGraph(60, 3, 9, seed);
+    const auto expected = bellmanFord(edges, 0);
+    const auto neighbours = [&edges](size_t state, const auto& visit) {
+      for (const auto& [to, weight] : edges[state]) {
+        visit(to, weight);
+      }
+    };
+
+    EXPECT_EQ(dial(edges.size(), {0}, neighbours, 9).distances(), expected) << seed;
+    EXPECT_EQ(aStar(
+                  edges.size(), {0}, neighbours, [](size_t) { return size_t{0}; },
+                  search_detail::NoGoal{})
+                  .distances(),
+              expected)
+        << seed;
+
+    const auto binary = randomGraph(60, 3, 1, seed);
+    const auto binaryNeighbours = [&binary](size_t state, const auto& visit) {
+      for (const auto& [to, weight] : binary[state]) {
+        visit(to, weight);
+      }
+    };
+    EXPECT_EQ(bfs01(binary.size(), {0}, binaryNeighbours).distances(), bellmanFord(binary, 0))
+        << seed;
+  }
+}
+
+TEST(SearchTest, dialTurns) {
+  // A line of 5 cells, state = (cell * 2) + heading (0 east, 1 west), turning costs 1000.
+  const auto neighbours = [](size_t state, const auto& visit) {
+    const auto cell = state / 2;
+    const auto heading = state % 2;
+    if (heading == 0 && cell < 4) {
+      visit(state + 2, 1);
+    }
+    if (heading == 1 && cell > 0) {
+      visit(state - 2, 1);
+    }
+    visit((cell * 2) + (1 - heading), 1000);
+  };
+
+  const auto result = dial(10, {4}, neighbours, 1000, [](size_t s) { return s == 1; }, true);
+  EXPECT_EQ(result.distance(1), 1002);
+  EXPECT_EQ(result.goal(), 1);
+  EXPECT_EQ(result.onShortestPaths({1}), (std::vector<size_t>{1, 3, 4, 5}));
+}
+
+TEST(SearchTest, aStar) {
+  const auto end = kMaze.state(4, 4);
+  const auto neighbours = [](size_t state, const auto& visit) {
+    kMaze.neighbours(state, [&visit](size_t next) { visit(next, 1); });
+  };
+  const auto manhattan = [](size_t state) {
+    return (4 - (state % kMaze.width())) + (4 - (state / kMaze.width()));
+  };
+
+  const auto result = aStar(kMaze.states(), {kMaze.state(0, 0)}, neighbours, manhattan,
+                            [end](size_t s) { return s == end; }, true);
+  EXPECT_EQ(result.distance(end), 8);
+  EXPECT_EQ(result.onShortestPaths({end}).size(), 9);
+}
@@ -1,9 +1,14 @@
 #include "lib/to.h"
 
+#include <array>
 #include <cstddef>
 #include <cstdint>
 #include <iterator>
+#include <memory_resource>
+#include <optional>
+#include <stdexcept>
 #include <string>
+#include <string_view>
 #include <utility>
 #include <vector>
 
@@ -98,3 +103,69 @@ TEST(ToTest, toContainerArithmeticfromString) {
 
   test("123", std::vector<size_t>{1, 2, 3});
 }
+
+TEST(ToTest, toArithmeticfromStringView) {
+  constexpr auto test = []<typename T>(std::string_view from, const T& expected) {
+    EXPECT_EQ(to<T>(from), expected);
+  };
+
+  test("123", 123);
+  test(" 123 ", 123UL);
+  test("+123", 123L);
+  test("-123", -123LL);
+  test("-1", static_cast<size_t>(-1));
+  test("12345678", 12345678UL);
+  test("123456789", 123456789UL);
+  test("1234567812345678", 1234567812345678UL);
+  test("12345678,9", 12345678UL);
+  test("18446744073709551615", UINT64_MAX);
+  test("00000000000000000000000042", 42UL);
+  test("9223372036854775807", INT64_MAX);
+  test("-9223372036854775808", INT64_MIN);
+  test("1.25", 1.25F);
+  test("-12.3", -12.3);
+
+  EXPECT_THROW(to<size_t>(std::string_view{""}), std::invalid_argument);
+  EXPECT_THROW(to<size_t>(std::string_view{"abc"}), std::invalid_argument);
+  EXPECT_THROW(to<size_t>(std::string_view{"18446744073709551616"}), std::invalid_argument);
+  EXPECT_THROW(to<int64_t>(std::string_view{"9223372036854775808"}), std::invalid_argument);
+  EXPECT_THROW(to<double>(std::string{"-"}), std::invalid_argument);
+}
+
+TEST(ToTest, fromChars) {
+  EXPECT_EQ(fromChars<size_t>("42abc"), 42UL);
+  EXPECT_EQ(fromChars<size_t>("\t\n 7"), 7UL);
+  EXPECT_EQ(fromChars<int>("- 7"), std::nullopt);
+  EXPECT_EQ(fromChars<int>(""), std::nullopt);
+  EXPECT_EQ(fromChars<double>("-5.5"), -5.5);
+  EXPECT_EQ(fromChars<double>("--5"), std::nullopt);
+  EXPECT_EQ(fromChars<double>("+-5"), std::nullopt);
+  EXPECT_EQ(fromChars<int>("--5"), std::nullopt);
+
+  for (size_t value = 1, digits = 1; digits <= 19; value *= 10, ++digits) {
+    EXPECT_EQ(fromChars<size_t>(std::to_string(value)), value);
+    EXPECT_EQ(fromChars<size_t>(std::to_string(value - 1)), value - 1);
+    EXPECT_EQ(fromChars<ssize_t>("-" + std::to_string(value)), -static_cast<ssize_t>(value));
+  }
+}
+
+TEST(ToTest, toPmrContainer) {
+  // Everything must come out of buffer: the upstream resource throws on any allocation.
+  std::array<std::byte, 4096> buffer{};
+  std::pmr::monotonic_buffer_resource resource{buffer.data(), buffer.size(),
+                                               std::pmr::null_memory_resource()};
+
+  const std::vector<std::string> from = {"1", "-2", "3"};
+  const auto nums = to<std::pmr::vector<ssize_t>>(from, &resource);
+  EXPECT_EQ(nums, (std::pmr::vector<ssize_t>{1, -2, 3}));
+  EXPECT_EQ(nums.get_allocator().resource(), &resource);
+
+  const std::vector<std::string_view> words = {"a string longer than any small string buffer", "b"};
+  const auto strings = to<std::pmr::vector<std::pmr::string>>(words, &resource);
+  ASSERT_EQ(strings.size(), 2);
+  EXPECT_EQ(std::string_view{strings[0]}, words[0]);
+  EXPECT_EQ(strings[0].get_allocator().resource(), &resource);
+
+  EXPECT_THROW((to<std::pmr::vector<int>>(std::vector<std::string>{"x"}, &resource)),
+               std::invalid_argument);
+}
@@ -0,0 +1,9 @@
+#include "benchmark/benchmark.h"
+
+static void BenchmarkTrivial(benchmark::State& state) {
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(state.iterations());
+  }
+}
+
+BENCHMARK(BenchmarkTrivial);
@@ -9,6 +9,7 @@ sudo dnf -y install 	\
 	clang-tools-extra 	\
 	fmt 				\
 	fmt-devel 			\
+	google-benchmark-devel \
 	gtest 				\
 	gtest-devel 		\
 	iwyu				\
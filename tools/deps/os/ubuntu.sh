@@ -2,6 +2,7 @@
 set -x -e
 sudo apt -y install		\
 	googletest			\
+	libbenchmark-dev	\
 	libboost-all-dev	\
 	libfmt-dev			\
 	libgtest-dev		\
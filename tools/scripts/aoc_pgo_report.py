@@ -0,0 +1,66 @@
+#!/usr/bin/env python3
+
+"""Compares the --bench-json results of a day's plain and PGO builds (see `make pgo`)."""
+
+import json
+import pathlib
+from typing import Dict, Tuple
+
+# (line of the run() call, part, "example" or "input"); a day may run a part more than once.
+Key = Tuple[int, int, str]
+
+
+def medians(path: pathlib.Path) -> Dict[Key, float]:
+    result = {}
+    for line in path.read_text().splitlines():
+        if line.strip():
+            record = json.loads(line)
+            key = (record["line"], record["part"], record["input"])
+            result[key] = float(record["wall_ns"]["median"])
+    return result
+
+
+def formatNanos(nanos: float) -> str:
+    for unit, scale in (("s", 1e9), ("ms", 1e6), ("us", 1e3)):
+        if nanos >= scale:
+            return f"{nanos / scale:.3f}{unit}"
+    return f"{nanos:.0f}ns"
+
+
+def report(name: str, plain: Dict[Key, float], pgo: Dict[Key, float]) -> None:
+    keys = sorted(plain.keys() & pgo.keys())
+    if not keys:
+        print(f"{name}: no parts to compare")
+        return
+
+    print(f"{name}: median wall time, plain vs PGO")
+    for key in keys:
+        line, part, kind = key
+        print(
+            f"  line {line:<4} part {part} {kind + ':':<8}"
+            f" {formatNanos(plain[key]):>12} {formatNanos(pgo[key]):>12}"
+            f" {plain[key] / pgo[key]:>7.2f}x"
+        )
+
+    plainTotal = sum(plain[key] for key in keys)
+    pgoTotal = sum(pgo[key] for key in keys)
+    print(
+        f"  {'total':<26} {formatNanos(plainTotal):>12} {formatNanos(pgoTotal):>12}"
+        f" {plainTotal / pgoTotal:>7.2f}x"
+    )
+
+
+if __name__ == "__main__":
+    import argparse
+
+    parser = argparse.ArgumentParser()
+    parser.add_argument("name", help="the day, for the heading")
+    parser.add_argument(
+        "plain", type=pathlib.Path, help="bench JSON lines of the plain build"
+    )
+    parser.add_argument(
+        "pgo", type=pathlib.Path, help="bench JSON lines of the PGO build"
+    )
+    args = parser.parse_args()
+
+    report(args.name, medians(args.plain), medians(args.pgo))